@@ -0,0 +1,39 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the critical section benchmark,
+ *            the critical section macros measure how long interrupts would stay masked
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_MESSAGES
+#define RTCOS_ENABLE_TIMERS
+
+#define RTCOS_MAX_TASKS_COUNT                    8
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            128
+#define RTCOS_MAX_MESSAGES_COUNT                 4
+#define RTCOS_MAX_TIMERS_COUNT                   8
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Functions                                                                                     */
+/*-----------------------------------------------------------------------------------------------*/
+void bench_enter_critical_section(void);
+void bench_exit_critical_section(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()           bench_enter_critical_section();
+#define RTCOS_EXIT_CRITICAL_SECTION()            bench_exit_critical_section();
+
+#endif /* RTCOS_CONFIG_H */
@@ -0,0 +1,262 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Measures the worst case time interrupts are masked by RTCOS and the time spent
+ *            in the tick interrupt, with pending future events and slow timer callbacks
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define BENCH_TICKS_COUNT                        200000uL
+#define BENCH_CALLBACK_DURATION_NS               5000uL
+#define TICK_TASK_ID                             (uint8_t)(RTCOS_MAX_TASKS_COUNT - 1)
+#define EVENT_TICK                               (uint32_t)0x80000000uL
+#define BENCH_HISTOGRAM_BUCKETS_COUNT            10000u
+#define BENCH_HISTOGRAM_BUCKET_NS                100u
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _worker_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                     void const *pvArg);
+static uint32_t _tick_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static void _on_timer_expired(void const *pvArg);
+static uint64_t _now_ns(void);
+static uint64_t _cpu_ns(void);
+static double _masked_percentile(double dPercent);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t u32Nesting;
+static uint64_t u64MaskStart;
+static uint64_t u64MaxMasked;
+static uint32_t u32MaskedCallbacks;
+static uint32_t u32MaxMaskedCallbacks;
+static uint32_t u32MaskedSectionsCount;
+static uint32_t tu32MaskedHistogram[BENCH_HISTOGRAM_BUCKETS_COUNT];
+static uint64_t u64TotalTickIsr;
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported functions                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Start measuring a masked section, only the outermost one is timed
+  * @return     Nothing
+  ********************************************************************************************** */
+void bench_enter_critical_section(void)
+{
+  if(0 == u32Nesting++)
+  {
+    u32MaskedCallbacks = 0;
+    u64MaskStart = _cpu_ns();
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Stop measuring a masked section and keep the longest one
+  * @return     Nothing
+  ********************************************************************************************** */
+void bench_exit_critical_section(void)
+{
+  uint64_t u64Masked;
+
+  if(0 == --u32Nesting)
+  {
+    u64Masked = _cpu_ns() - u64MaskStart;
+    if(u64Masked > u64MaxMasked)
+    {
+      u64MaxMasked = u64Masked;
+    }
+    if(u32MaskedCallbacks > u32MaxMaskedCallbacks)
+    {
+      u32MaxMaskedCallbacks = u32MaskedCallbacks;
+    }
+    u64Masked /= BENCH_HISTOGRAM_BUCKET_NS;
+    if(u64Masked >= BENCH_HISTOGRAM_BUCKETS_COUNT)
+    {
+      u64Masked = BENCH_HISTOGRAM_BUCKETS_COUNT - 1;
+    }
+    ++tu32MaskedHistogram[u64Masked];
+    ++u32MaskedSectionsCount;
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  uint8_t u08TaskID;
+  uint16_t u16Index;
+  rtcos_timer_id_t sTimerID;
+
+  rtcos_init();
+  for(u08TaskID = 0; u08TaskID < TICK_TASK_ID; ++u08TaskID)
+  {
+    rtcos_register_task_handler(_worker_task_handler, u08TaskID, NULL);
+  }
+  rtcos_register_task_handler(_tick_task_handler, TICK_TASK_ID, NULL);
+  /* Keep every future event slot busy with periodic events of various periods */
+  for(u16Index = 0; u16Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u16Index)
+  {
+    rtcos_send_event((uint8_t)(u16Index % TICK_TASK_ID),
+                     (uint32_t)1 << (u16Index / TICK_TASK_ID),
+                     10 + (u16Index * 7),
+                     true);
+  }
+  for(u16Index = 0; u16Index < RTCOS_MAX_TIMERS_COUNT; ++u16Index)
+  {
+    sTimerID = rtcos_create_timer(RTCOS_TIMER_PERIODIC, _on_timer_expired, NULL);
+    rtcos_start_timer(sTimerID, 50 + (u16Index * 13));
+  }
+  /* The lowest priority task plays the role of the tick interrupt */
+  rtcos_send_event(TICK_TASK_ID, EVENT_TICK, 0, false);
+  u64MaxMasked = 0;
+  u32MaxMaskedCallbacks = 0;
+  u32MaskedSectionsCount = 0;
+  rtcos_run();
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Handler of the tasks receiving the future events
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _worker_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  (void)u32EventFlags;
+  (void)u08MsgCount;
+  (void)pvArg;
+  return 0;
+}
+
+/** ***********************************************************************************************
+  * @brief      Handler of the task calling rtcos_update_tick() as a tick interrupt would
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _tick_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  uint64_t u64Start;
+  uint64_t u64Elapsed;
+
+  (void)u08MsgCount;
+  (void)pvArg;
+  u64Start = _cpu_ns();
+  rtcos_update_tick();
+  u64Elapsed = _cpu_ns() - u64Start;
+  u64TotalTickIsr += u64Elapsed;
+  if(rtcos_get_tick_count() >= BENCH_TICKS_COUNT)
+  {
+    printf("%-6s %-8s masked p99.9=%6.1f us max=%6.1f us  callbacks masked=%u  "
+           "tick isr avg=%6.3f us\r\n",
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+           "wheel",
+#else
+           "scan",
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+           "deferred",
+#else
+           "isr",
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+           _masked_percentile(99.9),
+           (double)u64MaxMasked / 1000.0,
+           (unsigned)u32MaxMaskedCallbacks,
+           (double)u64TotalTickIsr / (1000.0 * BENCH_TICKS_COUNT));
+    exit(0);
+  }
+  return u32EventFlags;
+}
+
+/** ***********************************************************************************************
+  * @brief      Slow timer callback
+  * @param      pvArg Additional argument passed to the timer callback
+  * @return     Returns nothing
+  ********************************************************************************************** */
+static void _on_timer_expired(void const *pvArg)
+{
+  uint64_t u64Start;
+
+  (void)pvArg;
+  if(0 != u32Nesting)
+  {
+    ++u32MaskedCallbacks;
+  }
+  u64Start = _now_ns();
+  while((_now_ns() - u64Start) < BENCH_CALLBACK_DURATION_NS);
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the host monotonic clock
+  * @return     Current time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _now_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the CPU time consumed by the calling thread, time spent preempted by the
+  *             host operating system is not accounted
+  * @return     Consumed CPU time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _cpu_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get a percentile of the masked sections duration
+  * @param      dPercent Requested percentile
+  * @return     Upper bound of the bucket holding the percentile in microseconds
+  ********************************************************************************************** */
+static double _masked_percentile(double dPercent)
+{
+  uint32_t u32Bucket;
+  uint64_t u64Count;
+  uint64_t u64Target;
+
+  u64Count = 0;
+  u64Target = (uint64_t)((dPercent * u32MaskedSectionsCount) / 100.0);
+  for(u32Bucket = 0; u32Bucket < (BENCH_HISTOGRAM_BUCKETS_COUNT - 1); ++u32Bucket)
+  {
+    u64Count += tu32MaskedHistogram[u32Bucket];
+    if(u64Count >= u64Target)
+    {
+      break;
+    }
+  }
+  return (double)((u32Bucket + 1) * BENCH_HISTOGRAM_BUCKET_NS) / 1000.0;
+}
@@ -0,0 +1,33 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the dispatch benchmark
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_MESSAGES
+
+/** The tasks count is swept from the command line, e.g. -DRTCOS_MAX_TASKS_COUNT=128 */
+#ifndef RTCOS_MAX_TASKS_COUNT
+#define RTCOS_MAX_TASKS_COUNT                    32
+#endif /* RTCOS_MAX_TASKS_COUNT */
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            2
+#define RTCOS_MAX_MESSAGES_COUNT                 2
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()
+#define RTCOS_EXIT_CRITICAL_SECTION()
+
+#endif /* RTCOS_CONFIG_H */
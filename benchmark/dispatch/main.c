@@ -0,0 +1,117 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Measures the cost of one dispatch through rtcos_run as the tasks count grows
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define BENCH_DISPATCHES_COUNT                   10000000uL
+#define BENCH_TASK_ID                            (uint8_t)(RTCOS_MAX_TASKS_COUNT - 1)
+#define EVENT_BENCH                              (uint32_t)1
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _idle_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static uint64_t _now_ns(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t u32Dispatches;
+static uint64_t u64StartTime;
+
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  uint8_t u08TaskID;
+
+  rtcos_init();
+  /* Every task is registered but only the lowest priority one ever gets an event,
+   * this is the worst case for a scheduler that scans the tasks array */
+  for(u08TaskID = 0; u08TaskID < BENCH_TASK_ID; ++u08TaskID)
+  {
+    rtcos_register_task_handler(_idle_task_handler, u08TaskID, NULL);
+  }
+  rtcos_register_task_handler(_bench_task_handler, BENCH_TASK_ID, NULL);
+  rtcos_send_event(BENCH_TASK_ID, EVENT_BENCH, 0, false);
+  u32Dispatches = 0;
+  u64StartTime = _now_ns();
+  rtcos_run();
+  return 0;
+}
+
+/** ***********************************************************************************************
+  * @brief      Handler of the tasks that never receive anything
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _idle_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  (void)u08MsgCount;
+  (void)pvArg;
+  return u32EventFlags;
+}
+
+/** ***********************************************************************************************
+  * @brief      Handler of the measured task, it posts itself the next event until done
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  uint64_t u64Elapsed;
+
+  (void)u08MsgCount;
+  (void)pvArg;
+  if(++u32Dispatches < BENCH_DISPATCHES_COUNT)
+  {
+    rtcos_send_event(BENCH_TASK_ID, EVENT_BENCH, 0, false);
+  }
+  else
+  {
+    u64Elapsed = _now_ns() - u64StartTime;
+    printf("tasks=%-4u dispatches=%lu ns/dispatch=%.2f\r\n",
+           (unsigned)RTCOS_MAX_TASKS_COUNT,
+           (unsigned long)u32Dispatches,
+           (double)u64Elapsed / (double)u32Dispatches);
+    exit(0);
+  }
+  return u32EventFlags & ~EVENT_BENCH;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the host monotonic clock
+  * @return     Current time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _now_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
@@ -0,0 +1,38 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the event posting benchmark,
+ *            the critical section counts how many times interrupts would be masked
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_MAX_TASKS_COUNT                    2
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            2
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Variables                                                                                     */
+/*-----------------------------------------------------------------------------------------------*/
+extern volatile uint32_t u32BenchMaskedCount;
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()           ++u32BenchMaskedCount;
+#define RTCOS_EXIT_CRITICAL_SECTION()
+
+#endif /* RTCOS_CONFIG_H */
@@ -0,0 +1,100 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Measures the cost of posting an immediate event the way a DMA or UART interrupt
+ *            would, and how many times interrupts get masked to do it
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define BENCH_POSTS_COUNT                        10000000uL
+#define BENCH_TASK_ID                            (uint8_t)0
+#define EVENT_RX_DONE                            (uint32_t)0x00000001uL
+
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+#define BENCH_POST_EVENT()                                                                        \
+  rtcos_send_event_from_isr(BENCH_TASK_ID, EVENT_RX_DONE)
+#define BENCH_LABEL                              "from_isr"
+#else
+#define BENCH_POST_EVENT()                                                                        \
+  rtcos_send_event(BENCH_TASK_ID, EVENT_RX_DONE, 0, false)
+#define BENCH_LABEL                              "masked  "
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static uint64_t _now_ns(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported variables                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+volatile uint32_t u32BenchMaskedCount;
+
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  uint32_t u32Index;
+  uint64_t u64Elapsed;
+
+  rtcos_init();
+  rtcos_register_task_handler(_bench_task_handler, BENCH_TASK_ID, NULL);
+  u32BenchMaskedCount = 0;
+  u64Elapsed = _now_ns();
+  for(u32Index = 0; u32Index < BENCH_POSTS_COUNT; ++u32Index)
+  {
+    BENCH_POST_EVENT();
+  }
+  u64Elapsed = _now_ns() - u64Elapsed;
+  printf("%s posts=%lu ns/post=%.2f masked/post=%.2f\r\n",
+         BENCH_LABEL,
+         (unsigned long)BENCH_POSTS_COUNT,
+         (double)u64Elapsed / (double)BENCH_POSTS_COUNT,
+         (double)u32BenchMaskedCount / (double)BENCH_POSTS_COUNT);
+  return 0;
+}
+
+/** ***********************************************************************************************
+  * @brief      Handler of the task receiving the events, never dispatched by this benchmark
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  (void)u08MsgCount;
+  (void)pvArg;
+  return u32EventFlags & ~EVENT_RX_DONE;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the host monotonic clock
+  * @return     Current time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _now_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
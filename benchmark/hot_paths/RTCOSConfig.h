@@ -0,0 +1,41 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the hot paths benchmark,
+ *            every RTCOS_MAX_* value can be swept from the command line
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_MESSAGES
+#define RTCOS_ENABLE_TIMERS
+
+#ifndef RTCOS_MAX_TASKS_COUNT
+#define RTCOS_MAX_TASKS_COUNT                    8
+#endif /* RTCOS_MAX_TASKS_COUNT */
+#ifndef RTCOS_MAX_FUTURE_EVENTS_COUNT
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            16
+#endif /* RTCOS_MAX_FUTURE_EVENTS_COUNT */
+#ifndef RTCOS_MAX_MESSAGES_COUNT
+#define RTCOS_MAX_MESSAGES_COUNT                 8
+#endif /* RTCOS_MAX_MESSAGES_COUNT */
+#ifndef RTCOS_MAX_TIMERS_COUNT
+#define RTCOS_MAX_TIMERS_COUNT                   8
+#endif /* RTCOS_MAX_TIMERS_COUNT */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()
+#define RTCOS_EXIT_CRITICAL_SECTION()
+
+#endif /* RTCOS_CONFIG_H */
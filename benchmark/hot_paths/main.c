@@ -0,0 +1,326 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Measures the scheduler hot paths one operation at a time and reports the mean,
+ *            p50, p99 and max cost of each of them
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define BENCH_SAMPLES_COUNT                      100000uL
+/** The measured task has the lowest priority so that the sink tasks drain their messages first */
+#define BENCH_TASK_ID                            (uint8_t)(RTCOS_MAX_TASKS_COUNT - 1)
+#define SINK_TASK_ID                             (uint8_t)0
+/** Future events and timers used as load never expire during the benchmark */
+#define BENCH_LOAD_DELAY                         100000000uL
+#define BENCH_MEASURED_DELAY                     1000uL
+#define EVENT_SINK                               (uint32_t)0x00000001uL
+#define EVENT_STEP                               (uint32_t)0x80000000uL
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private types                                                                                 */
+/*-----------------------------------------------------------------------------------------------*/
+/** Measurements done in order by the benchmark task */
+typedef enum
+{
+  BENCH_SEND_EVENT_IMMEDIATE = 0,
+  BENCH_SEND_EVENT_FUTURE,
+  BENCH_BROADCAST_EVENT,
+  BENCH_BROADCAST_MESSAGE,
+  BENCH_MESSAGE_ROUND_TRIP,
+  BENCH_UPDATE_TICK,
+  BENCH_DISPATCH,
+  BENCH_DONE,
+}bench_step_t;
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _sink_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static void _load_future_events_and_timers(void);
+static void _report(char const *pcName);
+static int _compare_samples(void const *pvLeft, void const *pvRight);
+static uint64_t _now_ns(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t tu32Samples[BENCH_SAMPLES_COUNT];
+static uint32_t u32SamplesCount;
+static uint32_t u32ClockOverhead;
+static uint64_t u64PostTime;
+static bench_step_t eStep;
+static char const cMessage[] = "bench";
+
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  uint8_t u08TaskID;
+  uint32_t u32Index;
+  uint64_t u64Start;
+
+  /* Cost of reading the clock, removed from every sample */
+  u32ClockOverhead = 0xFFFFFFFFuL;
+  for(u32Index = 0; u32Index < 1000; ++u32Index)
+  {
+    u64Start = _now_ns();
+    u64Start = _now_ns() - u64Start;
+    if(u64Start < u32ClockOverhead)
+    {
+      u32ClockOverhead = (uint32_t)u64Start;
+    }
+  }
+  rtcos_init();
+  for(u08TaskID = 0; u08TaskID < BENCH_TASK_ID; ++u08TaskID)
+  {
+    rtcos_register_task_handler(_sink_task_handler, u08TaskID, NULL);
+  }
+  rtcos_register_task_handler(_bench_task_handler, BENCH_TASK_ID, NULL);
+  printf("tasks=%u future_events=%u messages=%u timers=%u\r\n",
+         (unsigned)RTCOS_MAX_TASKS_COUNT, (unsigned)RTCOS_MAX_FUTURE_EVENTS_COUNT,
+         (unsigned)RTCOS_MAX_MESSAGES_COUNT, (unsigned)RTCOS_MAX_TIMERS_COUNT);
+  _load_future_events_and_timers();
+  eStep = BENCH_SEND_EVENT_IMMEDIATE;
+  rtcos_send_event(BENCH_TASK_ID, EVENT_STEP, 0, false);
+  rtcos_run();
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Handler of the tasks that receive the events and messages, drains everything
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _sink_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  void *pvMsg;
+
+  (void)u32EventFlags;
+  (void)pvArg;
+  while(u08MsgCount--)
+  {
+    rtcos_get_message(&pvMsg);
+  }
+  return 0;
+}
+
+/** ***********************************************************************************************
+  * @brief      Handler of the benchmark task. Operations that leave work for the other tasks take
+  *             one sample per dispatch, the other ones take all their samples at once.
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  uint64_t u64Start;
+  void *pvMsg;
+
+  (void)u08MsgCount;
+  (void)pvArg;
+  u64Start = _now_ns();
+  switch(eStep)
+  {
+  case BENCH_SEND_EVENT_IMMEDIATE:
+    for(u32SamplesCount = 0; u32SamplesCount < BENCH_SAMPLES_COUNT; ++u32SamplesCount)
+    {
+      u64Start = _now_ns();
+      rtcos_send_event(SINK_TASK_ID, EVENT_SINK, 0, false);
+      tu32Samples[u32SamplesCount] = (uint32_t)(_now_ns() - u64Start);
+    }
+    _report("send_event/immediate");
+    break;
+  case BENCH_SEND_EVENT_FUTURE:
+    /* Every other future event slot is in use, this one is added then deleted again */
+    for(u32SamplesCount = 0; u32SamplesCount < BENCH_SAMPLES_COUNT; ++u32SamplesCount)
+    {
+      u64Start = _now_ns();
+      rtcos_send_event(SINK_TASK_ID, EVENT_SINK, BENCH_MEASURED_DELAY, false);
+      tu32Samples[u32SamplesCount] = (uint32_t)(_now_ns() - u64Start);
+      rtcos_clear_event(SINK_TASK_ID, EVENT_SINK);
+    }
+    _report("send_event/future");
+    break;
+  case BENCH_BROADCAST_EVENT:
+    for(u32SamplesCount = 0; u32SamplesCount < BENCH_SAMPLES_COUNT; ++u32SamplesCount)
+    {
+      u64Start = _now_ns();
+      rtcos_broadcast_event(EVENT_SINK, 0, false);
+      tu32Samples[u32SamplesCount] = (uint32_t)(_now_ns() - u64Start);
+    }
+    /* The benchmark task received its own broadcast */
+    u32EventFlags &= ~EVENT_SINK;
+    _report("broadcast_event");
+    break;
+  case BENCH_BROADCAST_MESSAGE:
+    /* The sink tasks drain their fifo between two samples */
+    while(0 != u08MsgCount--)
+    {
+      rtcos_get_message(&pvMsg);
+    }
+    u64Start = _now_ns();
+    rtcos_broadcast_message((void *)cMessage);
+    tu32Samples[u32SamplesCount] = (uint32_t)(_now_ns() - u64Start);
+    if(++u32SamplesCount >= BENCH_SAMPLES_COUNT)
+    {
+      _report("broadcast_message");
+    }
+    break;
+  case BENCH_MESSAGE_ROUND_TRIP:
+    while(0 != u08MsgCount--)
+    {
+      rtcos_get_message(&pvMsg);
+    }
+    for(u32SamplesCount = 0; u32SamplesCount < BENCH_SAMPLES_COUNT; ++u32SamplesCount)
+    {
+      u64Start = _now_ns();
+      rtcos_send_message(BENCH_TASK_ID, (void *)cMessage);
+      rtcos_get_message(&pvMsg);
+      tu32Samples[u32SamplesCount] = (uint32_t)(_now_ns() - u64Start);
+    }
+    _report("send_message+get_message");
+    break;
+  case BENCH_UPDATE_TICK:
+    for(u32SamplesCount = 0; u32SamplesCount < BENCH_SAMPLES_COUNT; ++u32SamplesCount)
+    {
+      u64Start = _now_ns();
+      rtcos_update_tick();
+      tu32Samples[u32SamplesCount] = (uint32_t)(_now_ns() - u64Start);
+    }
+    _report("update_tick");
+    break;
+  case BENCH_DISPATCH:
+    /* Time from posting an event to the start of the handler, through rtcos_run */
+    if(0 != u64PostTime)
+    {
+      tu32Samples[u32SamplesCount++] = (uint32_t)(u64Start - u64PostTime);
+    }
+    if(u32SamplesCount >= BENCH_SAMPLES_COUNT)
+    {
+      _report("dispatch_latency");
+    }
+    break;
+  default:
+    exit(0);
+    break;
+  }
+  if(BENCH_DISPATCH == eStep)
+  {
+    u64PostTime = _now_ns();
+  }
+  rtcos_send_event(BENCH_TASK_ID, EVENT_STEP, 0, false);
+  return u32EventFlags & ~EVENT_STEP;
+}
+
+/** ***********************************************************************************************
+  * @brief      Fill all the future event slots but one and start all the timers, with delays long
+  *             enough to never expire, so that the measured paths see a loaded system
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _load_future_events_and_timers(void)
+{
+  uint32_t u32Index;
+  uint8_t u08TaskID;
+  uint8_t u08Bit;
+  rtcos_timer_id_t sTimerID;
+
+  u32Index = 0;
+  /* Bit 0 of the sink task is kept for the measured future event */
+  for(u08TaskID = 0; u08TaskID < BENCH_TASK_ID; ++u08TaskID)
+  {
+    for(u08Bit = 1; (u08Bit < 31) && ((u32Index + 1) < RTCOS_MAX_FUTURE_EVENTS_COUNT); ++u08Bit)
+    {
+      rtcos_send_event(u08TaskID, (uint32_t)1 << u08Bit, BENCH_LOAD_DELAY, false);
+      ++u32Index;
+    }
+  }
+  for(u32Index = 0; u32Index < RTCOS_MAX_TIMERS_COUNT; ++u32Index)
+  {
+    sTimerID = rtcos_create_timer(RTCOS_TIMER_PERIODIC, NULL, NULL);
+    if(sTimerID >= 0)
+    {
+      rtcos_start_timer(sTimerID, BENCH_LOAD_DELAY);
+    }
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Print the statistics of the samples taken for one operation and move to the next
+  * @param      pcName Name of the measured operation
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _report(char const *pcName)
+{
+  uint64_t u64Sum;
+  uint32_t u32Index;
+
+  u64Sum = 0;
+  for(u32Index = 0; u32Index < u32SamplesCount; ++u32Index)
+  {
+    tu32Samples[u32Index] = (tu32Samples[u32Index] > u32ClockOverhead) ?
+                            (tu32Samples[u32Index] - u32ClockOverhead) : 0;
+    u64Sum += tu32Samples[u32Index];
+  }
+  qsort(tu32Samples, u32SamplesCount, sizeof(tu32Samples[0]), _compare_samples);
+  printf("%-26s mean=%8.1f ns p50=%6lu ns p99=%6lu ns max=%8lu ns\r\n",
+         pcName,
+         (double)u64Sum / (double)u32SamplesCount,
+         (unsigned long)tu32Samples[u32SamplesCount / 2],
+         (unsigned long)tu32Samples[(u32SamplesCount * 99) / 100],
+         (unsigned long)tu32Samples[u32SamplesCount - 1]);
+  u32SamplesCount = 0;
+  ++eStep;
+}
+
+/** ***********************************************************************************************
+  * @brief      Order two samples for qsort
+  * @param      pvLeft First sample
+  * @param      pvRight Second sample
+  * @return     Negative, zero or positive like strcmp
+  ********************************************************************************************** */
+static int _compare_samples(void const *pvLeft, void const *pvRight)
+{
+  uint32_t u32Left;
+  uint32_t u32Right;
+
+  u32Left = *(uint32_t const *)pvLeft;
+  u32Right = *(uint32_t const *)pvRight;
+  return (u32Left > u32Right) - (u32Left < u32Right);
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the host monotonic clock
+  * @return     Current time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _now_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
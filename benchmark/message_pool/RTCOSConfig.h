@@ -0,0 +1,35 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the message pool benchmark
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_MESSAGE_POOLS
+
+#ifndef BENCH_RECEIVERS_COUNT
+#define BENCH_RECEIVERS_COUNT                    8
+#endif /* BENCH_RECEIVERS_COUNT */
+
+#define RTCOS_MAX_TASKS_COUNT                    (BENCH_RECEIVERS_COUNT + 1)
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            2
+#define RTCOS_MAX_MESSAGES_COUNT                 4
+#define RTCOS_MESSAGE_POOLS(X)                   X(64, 4) X(256, 4) X(1024, 4)
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()
+#define RTCOS_EXIT_CRITICAL_SECTION()
+
+#endif /* RTCOS_CONFIG_H */
@@ -0,0 +1,168 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Measures the cost of broadcasting a payload to every receiver task, either copied
+ *            into one heap buffer per receiver or shared through a reference-counted pool message
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+/** Size of the broadcast payload in bytes */
+#ifndef BENCH_PAYLOAD_SIZE
+#define BENCH_PAYLOAD_SIZE                       256
+#endif /* BENCH_PAYLOAD_SIZE */
+#define BENCH_BROADCASTS_COUNT                   1000000uL
+#define PRODUCER_TASK_ID                         (uint8_t)BENCH_RECEIVERS_COUNT
+#define EVENT_PRODUCE                            (uint32_t)1
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _receiver_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg);
+static uint32_t _producer_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg);
+static uint64_t _now_ns(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static uint8_t tu08Payload[BENCH_PAYLOAD_SIZE];
+static uint32_t u32BroadcastsCount;
+static uint32_t u32Checksum;
+static uint64_t u64StartTime;
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported functions                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  uint8_t u08TaskID;
+
+  rtcos_init();
+  for(u08TaskID = 0; u08TaskID < BENCH_RECEIVERS_COUNT; ++u08TaskID)
+  {
+    rtcos_register_task_handler(_receiver_task_handler, u08TaskID, NULL);
+  }
+  rtcos_register_task_handler(_producer_task_handler, PRODUCER_TASK_ID, NULL);
+  memset(tu08Payload, 0x5A, sizeof(tu08Payload));
+  u64StartTime = _now_ns();
+  rtcos_send_event(PRODUCER_TASK_ID, EVENT_PRODUCE, 0, false);
+  rtcos_run();
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Receiver task, reads its messages and gives them back
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _receiver_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg)
+{
+  void *pvMsg;
+
+  (void)u32EventFlags;
+  (void)u08MsgCount;
+  (void)pvArg;
+  while(RTCOS_ERR_NONE == rtcos_get_message(&pvMsg))
+  {
+    u32Checksum += ((uint8_t *)pvMsg)[BENCH_PAYLOAD_SIZE - 1];
+#ifdef BENCH_COPY
+    free(pvMsg);
+#else
+    rtcos_msg_release(pvMsg);
+#endif /* BENCH_COPY */
+  }
+  return 0;
+}
+
+/** ***********************************************************************************************
+  * @brief      Producer task, broadcasts one payload per dispatch, the receivers have a higher
+  *             priority and drain their messages in between
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _producer_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg)
+{
+  void *pvMsg;
+  uint8_t u08TaskID;
+  double dElapsed;
+
+  (void)u08MsgCount;
+  (void)pvArg;
+  /* The broadcast also reaches the producer, which drops its own copy */
+  while(RTCOS_ERR_NONE == rtcos_get_message(&pvMsg))
+  {
+    rtcos_msg_release(pvMsg);
+  }
+  if(BENCH_BROADCASTS_COUNT == u32BroadcastsCount)
+  {
+    dElapsed = (double)(_now_ns() - u64StartTime);
+    printf("%-5s receivers=%d payload=%d ns/broadcast=%.1f checksum=%lu\r\n",
+#ifdef BENCH_COPY
+           "copy",
+#else
+           "pool",
+#endif /* BENCH_COPY */
+           BENCH_RECEIVERS_COUNT, BENCH_PAYLOAD_SIZE, dElapsed / BENCH_BROADCASTS_COUNT,
+           (unsigned long)u32Checksum);
+    exit(0);
+  }
+#ifdef BENCH_COPY
+  for(u08TaskID = 0; u08TaskID < BENCH_RECEIVERS_COUNT; ++u08TaskID)
+  {
+    pvMsg = malloc(BENCH_PAYLOAD_SIZE);
+    memcpy(pvMsg, tu08Payload, BENCH_PAYLOAD_SIZE);
+    rtcos_send_message(u08TaskID, pvMsg);
+  }
+#else
+  (void)u08TaskID;
+  pvMsg = rtcos_msg_alloc(BENCH_PAYLOAD_SIZE);
+  memcpy(pvMsg, tu08Payload, BENCH_PAYLOAD_SIZE);
+  rtcos_broadcast_message(pvMsg);
+  rtcos_msg_release(pvMsg);
+#endif /* BENCH_COPY */
+  ++u32BroadcastsCount;
+  return u32EventFlags;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the host monotonic clock
+  * @return     Current time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _now_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
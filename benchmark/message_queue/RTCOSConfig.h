@@ -0,0 +1,37 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the message queue benchmark,
+ *            the critical section is a host mutex shared with the producer threads
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_MESSAGES
+
+#define RTCOS_MAX_TASKS_COUNT                    2
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            2
+#define RTCOS_MAX_MESSAGES_COUNT                 64
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Functions                                                                                     */
+/*-----------------------------------------------------------------------------------------------*/
+void bench_enter_critical_section(void);
+void bench_exit_critical_section(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()           bench_enter_critical_section();
+#define RTCOS_EXIT_CRITICAL_SECTION()            bench_exit_critical_section();
+
+#endif /* RTCOS_CONFIG_H */
@@ -0,0 +1,278 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Measures the messages throughput from producer threads to a consumer task,
+ *            with the regular fifo protected by the critical section or the lock-free ring,
+ *            one message at a time or in batches
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+/** Number of producer threads, 0 makes a task of the scheduler produce the messages */
+#ifndef BENCH_PRODUCERS_COUNT
+#define BENCH_PRODUCERS_COUNT                    1
+#endif /* BENCH_PRODUCERS_COUNT */
+/** Number of messages the consumer drains and the producer task sends per call, 1 uses the single
+  * message API */
+#ifndef BENCH_BATCH_SIZE
+#define BENCH_BATCH_SIZE                         1
+#endif /* BENCH_BATCH_SIZE */
+#define BENCH_MAX_PRODUCERS_COUNT                16
+#define BENCH_MESSAGES_COUNT                     4000000uL
+#define CONSUMER_TASK_ID                         (uint8_t)0
+#define PRODUCER_TASK_ID                         (uint8_t)1
+#define EVENT_PRODUCE                            (uint32_t)1
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _consumer_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg);
+static uint32_t _producer_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg);
+static void _idle_handler(void);
+#if (BENCH_PRODUCERS_COUNT > 0)
+static void *_producer_thread(void *pvArg);
+#endif /* BENCH_PRODUCERS_COUNT */
+static uint64_t _now_ns(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static pthread_mutex_t stCriticalSection;
+static uint32_t tu32NextSequence[BENCH_MAX_PRODUCERS_COUNT + 1];
+static uint32_t u32ProducedCount;
+static uint32_t u32ConsumedCount;
+static uint64_t u64StartTime;
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported functions                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Enter the critical section shared by the scheduler and the producers
+  * @return     Nothing
+  ********************************************************************************************** */
+void bench_enter_critical_section(void)
+{
+  pthread_mutex_lock(&stCriticalSection);
+}
+
+/** ***********************************************************************************************
+  * @brief      Exit the critical section shared by the scheduler and the producers
+  * @return     Nothing
+  ********************************************************************************************** */
+void bench_exit_critical_section(void)
+{
+  pthread_mutex_unlock(&stCriticalSection);
+}
+
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  pthread_mutexattr_t stAttr;
+#if (BENCH_PRODUCERS_COUNT > 0)
+  pthread_t tstThreads[BENCH_MAX_PRODUCERS_COUNT];
+  uintptr_t uIndex;
+#endif /* BENCH_PRODUCERS_COUNT */
+
+  pthread_mutexattr_init(&stAttr);
+  pthread_mutexattr_settype(&stAttr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&stCriticalSection, &stAttr);
+  rtcos_init();
+  rtcos_register_task_handler(_consumer_task_handler, CONSUMER_TASK_ID, NULL);
+  rtcos_register_task_handler(_producer_task_handler, PRODUCER_TASK_ID, NULL);
+  rtcos_register_idle_handler(_idle_handler);
+  u64StartTime = _now_ns();
+#if (BENCH_PRODUCERS_COUNT > 0)
+  for(uIndex = 0; uIndex < BENCH_PRODUCERS_COUNT; ++uIndex)
+  {
+    pthread_create(&tstThreads[uIndex], NULL, _producer_thread, (void *)(uIndex + 1));
+  }
+#else
+  rtcos_send_event(PRODUCER_TASK_ID, EVENT_PRODUCE, 0, false);
+#endif /* BENCH_PRODUCERS_COUNT */
+  rtcos_run();
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Encode a message so that the consumer can check the per producer ordering
+  * @param      uProducer Producer index starting from 1
+  * @param      u32Sequence Sequence number of the message for this producer
+  * @return     Message pointer, never NULL
+  ********************************************************************************************** */
+static void *_encode_message(uintptr_t uProducer, uint32_t u32Sequence)
+{
+  return (void *)((uProducer << 24) | (uintptr_t)u32Sequence);
+}
+
+/** ***********************************************************************************************
+  * @brief      Consumer task, drains its messages and checks their order
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _consumer_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg)
+{
+  void *tpvMsgs[BENCH_BATCH_SIZE];
+  void *pvMsg;
+  uint8_t u08Count;
+  uint8_t u08Index;
+  uintptr_t uProducer;
+  double dSeconds;
+
+  (void)u32EventFlags;
+  (void)u08MsgCount;
+  (void)pvArg;
+  do
+  {
+#if (BENCH_BATCH_SIZE > 1)
+    u08Count = rtcos_get_messages(tpvMsgs, BENCH_BATCH_SIZE);
+#else
+    u08Count = (RTCOS_ERR_NONE == rtcos_get_message(&tpvMsgs[0]))?1:0;
+#endif /* BENCH_BATCH_SIZE */
+    for(u08Index = 0; u08Index < u08Count; ++u08Index)
+    {
+      pvMsg = tpvMsgs[u08Index];
+      uProducer = (uintptr_t)pvMsg >> 24;
+      if(((uintptr_t)pvMsg & 0xFFFFFFuL) != tu32NextSequence[uProducer]++)
+      {
+        printf("message out of order from producer %u\r\n", (unsigned)uProducer);
+        exit(1);
+      }
+      if(++u32ConsumedCount == BENCH_MESSAGES_COUNT)
+      {
+        dSeconds = (double)(_now_ns() - u64StartTime) / 1e9;
+        printf("%-9s producers=%d batch=%d messages=%lu Mmsg/s=%.2f\r\n",
+#if defined(RTCOS_ENABLE_LOCKFREE_MESSAGES) && defined(RTCOS_LOCKFREE_SINGLE_PRODUCER)
+               "spsc",
+#elif defined(RTCOS_ENABLE_LOCKFREE_MESSAGES)
+               "mpsc",
+#else
+               "fifo",
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+               BENCH_PRODUCERS_COUNT, BENCH_BATCH_SIZE, BENCH_MESSAGES_COUNT,
+               BENCH_MESSAGES_COUNT / (dSeconds * 1e6));
+        exit(0);
+      }
+    }
+  }while(u08Count > 0);
+  return 0;
+}
+
+/** ***********************************************************************************************
+  * @brief      Producer task used when no producer thread is started,
+  *             fills the consumer fifo then yields to let it drain
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task argument
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _producer_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount,
+                                       void const *pvArg)
+{
+#if (BENCH_BATCH_SIZE > 1)
+  void *tpvMsgs[BENCH_BATCH_SIZE];
+  uint8_t u08Count;
+  uint8_t u08Sent;
+#endif /* BENCH_BATCH_SIZE */
+
+  (void)u08MsgCount;
+  (void)pvArg;
+#if (BENCH_BATCH_SIZE > 1)
+  do
+  {
+    for(u08Count = 0; (u08Count < BENCH_BATCH_SIZE) &&
+                      ((u32ProducedCount + u08Count) < BENCH_MESSAGES_COUNT); ++u08Count)
+    {
+      tpvMsgs[u08Count] = _encode_message(1, (u32ProducedCount + u08Count) & 0xFFFFFFuL);
+    }
+    u08Sent = rtcos_send_messages(CONSUMER_TASK_ID, tpvMsgs, u08Count);
+    u32ProducedCount += u08Sent;
+  }while((u08Count > 0) && (u08Sent == u08Count));
+#else
+  while((u32ProducedCount < BENCH_MESSAGES_COUNT) &&
+        (RTCOS_ERR_NONE == rtcos_send_message(CONSUMER_TASK_ID,
+                                              _encode_message(1, u32ProducedCount & 0xFFFFFFuL))))
+  {
+    ++u32ProducedCount;
+  }
+#endif /* BENCH_BATCH_SIZE */
+  return u32EventFlags;
+}
+
+/** ***********************************************************************************************
+  * @brief      Idle handler, gives the CPU to the producer threads
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _idle_handler(void)
+{
+  sched_yield();
+}
+
+#if (BENCH_PRODUCERS_COUNT > 0)
+/** ***********************************************************************************************
+  * @brief      Producer thread, sends its share of messages and retries while the fifo is full
+  * @param      pvArg Producer index starting from 1
+  * @return     Nothing
+  ********************************************************************************************** */
+static void *_producer_thread(void *pvArg)
+{
+  uint32_t u32Sequence;
+  uint32_t u32Count;
+
+  u32Count = BENCH_MESSAGES_COUNT / BENCH_PRODUCERS_COUNT;
+  if(1 == (uintptr_t)pvArg)
+  {
+    u32Count += BENCH_MESSAGES_COUNT % BENCH_PRODUCERS_COUNT;
+  }
+  for(u32Sequence = 0; u32Sequence < u32Count; ++u32Sequence)
+  {
+    while(RTCOS_ERR_NONE !=
+          rtcos_send_message(CONSUMER_TASK_ID,
+                             _encode_message((uintptr_t)pvArg, u32Sequence & 0xFFFFFFuL)))
+    {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+#endif /* BENCH_PRODUCERS_COUNT */
+
+/** ***********************************************************************************************
+  * @brief      Read the host monotonic clock
+  * @return     Current time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _now_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
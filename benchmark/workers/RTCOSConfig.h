@@ -0,0 +1,40 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the workers scaling benchmark,
+ *            the critical section is a host mutex shared by the worker threads
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_WORKERS
+
+/** The workers count is swept from the command line, e.g. -DRTCOS_WORKERS_COUNT=8 */
+#ifndef RTCOS_WORKERS_COUNT
+#define RTCOS_WORKERS_COUNT                      1
+#endif /* RTCOS_WORKERS_COUNT */
+#define RTCOS_MAX_TASKS_COUNT                    64
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            2
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Functions                                                                                     */
+/*-----------------------------------------------------------------------------------------------*/
+void bench_enter_critical_section(void);
+void bench_exit_critical_section(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()           bench_enter_critical_section();
+#define RTCOS_EXIT_CRITICAL_SECTION()            bench_exit_critical_section();
+
+#endif /* RTCOS_CONFIG_H */
@@ -0,0 +1,148 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Measures the task handlers throughput of the worker threads backend as the workers
+ *            count grows, and checks that a task handler never runs on two workers at once
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define BENCH_RUNS_COUNT                         1000000uL
+/** CPU time burnt by every handler run */
+#define BENCH_WORK_NS                            1000uL
+#define EVENT_WORK                               (uint32_t)1
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static uint64_t _now_ns(void);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static pthread_mutex_t stCriticalSection;
+static _Atomic uint32_t u32RunsCount;
+static _Atomic uint8_t tu08Running[RTCOS_MAX_TASKS_COUNT];
+static uint64_t u64StartTime;
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported functions                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Enter the critical section shared by the workers
+  * @return     Nothing
+  ********************************************************************************************** */
+void bench_enter_critical_section(void)
+{
+  pthread_mutex_lock(&stCriticalSection);
+}
+
+/** ***********************************************************************************************
+  * @brief      Exit the critical section shared by the workers
+  * @return     Nothing
+  ********************************************************************************************** */
+void bench_exit_critical_section(void)
+{
+  pthread_mutex_unlock(&stCriticalSection);
+}
+
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  pthread_mutexattr_t stAttr;
+  uintptr_t uTaskID;
+
+  pthread_mutexattr_init(&stAttr);
+  pthread_mutexattr_settype(&stAttr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&stCriticalSection, &stAttr);
+  rtcos_init();
+  for(uTaskID = 0; uTaskID < RTCOS_MAX_TASKS_COUNT; ++uTaskID)
+  {
+    rtcos_register_task_handler(_bench_task_handler, (uint8_t)uTaskID, (void *)uTaskID);
+  }
+  for(uTaskID = 0; uTaskID < RTCOS_MAX_TASKS_COUNT; ++uTaskID)
+  {
+    rtcos_send_event((uint8_t)uTaskID, EVENT_WORK, 0, false);
+  }
+  u64StartTime = _now_ns();
+  rtcos_run();
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Handler shared by all the tasks: burn some CPU time then post itself the next event
+  * @param      u32EventFlags Bit feild event
+  * @param      u08MsgCount number of messages belonging to this task
+  * @param      pvArg Task ID
+  * @return     Return unhandled events
+  ********************************************************************************************** */
+static uint32_t _bench_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  uint8_t u08TaskID;
+  uint64_t u64End;
+  uint64_t u64Elapsed;
+  uint32_t u32Runs;
+
+  (void)u08MsgCount;
+  u08TaskID = (uint8_t)(uintptr_t)pvArg;
+  if(0 != atomic_exchange(&tu08Running[u08TaskID], 1))
+  {
+    printf("task %u runs on two workers at once\r\n", (unsigned)u08TaskID);
+    exit(1);
+  }
+  u64End = _now_ns() + BENCH_WORK_NS;
+  while(_now_ns() < u64End);
+  atomic_store(&tu08Running[u08TaskID], 0);
+  u32Runs = atomic_fetch_add(&u32RunsCount, 1) + 1;
+  if(u32Runs < BENCH_RUNS_COUNT)
+  {
+    rtcos_send_event(u08TaskID, EVENT_WORK, 0, false);
+  }
+  else if(u32Runs == BENCH_RUNS_COUNT)
+  {
+    u64Elapsed = _now_ns() - u64StartTime;
+    printf("workers=%-3u runs=%lu Mruns/s=%.3f\r\n",
+           (unsigned)RTCOS_WORKERS_COUNT,
+           (unsigned long)u32Runs,
+           (double)u32Runs * 1000.0 / (double)u64Elapsed);
+    exit(0);
+  }
+  return u32EventFlags & ~EVENT_WORK;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the host monotonic clock
+  * @return     Current time in nanoseconds
+  ********************************************************************************************** */
+static uint64_t _now_ns(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint64_t)stTime.tv_sec * 1000000000uLL) + (uint64_t)stTime.tv_nsec;
+}
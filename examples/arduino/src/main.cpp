@@ -51,7 +51,7 @@ static uint8_t u08LedState;
   ********************************************************************************************** */
 void setup()
 {
-  uint8_t u08OsTimerID;
+  rtcos_timer_id_t sOsTimerID;
 
   u08LedState = LOW;
   pinMode(LED_BUILTIN, OUTPUT);
@@ -65,8 +65,8 @@ void setup()
   rtcos_register_task_handler(_task_one_handler, TASK_ID_PRIORITY_ONE, (void *)"TaskOne");
   rtcos_register_task_handler(_task_two_handler, TASK_ID_PRIORITY_TWO, (void *)"TaskTwo");
   rtcos_send_event(TASK_ID_PRIORITY_ONE, EVENT_PING, (uint32_t)0, false);
-  u08OsTimerID = rtcos_create_timer(RTCOS_TIMER_PERIODIC, _on_os_timer_expired, (void *)"blink");
-  rtcos_start_timer(u08OsTimerID, SOFTWARE_TIMER_PERIOD_IN_MS);
+  sOsTimerID = rtcos_create_timer(RTCOS_TIMER_PERIODIC, _on_os_timer_expired, (void *)"blink");
+  rtcos_start_timer(sOsTimerID, SOFTWARE_TIMER_PERIOD_IN_MS);
   rtcos_broadcast_event(EVENT_COMMON, 0, false);
   rtcos_broadcast_message((void *)"Hello");
 
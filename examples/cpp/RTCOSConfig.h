@@ -0,0 +1,30 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration of the C++ example
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+/* The POSIX port provides the critical section, the wakeup hook and enables the tickless mode */
+#include "rtcos_port.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_MESSAGES
+
+#define RTCOS_MAX_TASKS_COUNT                    2
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            2
+#define RTCOS_MAX_MESSAGES_COUNT                 2
+
+#endif /* RTCOS_CONFIG_H */
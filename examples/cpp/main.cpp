@@ -0,0 +1,124 @@
+/*
+ **************************************************************************************************
+ *
+ * @file    : main.cpp
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : C++ example program, the ping pong of the x86 example written with rtcos.hpp
+ *
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "rtcos.hpp"
+#include "rtcos_posix.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define TICK_PERIOD_US                           1000uL
+#define PING_PONG_DELAY_TICKS                    1000uL
+#define PING_PONG_ROUNDS                         5uL
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Types                                                                                         */
+/*-----------------------------------------------------------------------------------------------*/
+/** Events of task one, each enumerator is a bit position */
+enum class PingEvent : uint8_t
+{
+  Ping = 0,
+  Stop = 1,
+};
+RTCOS_EVENT_ENUM(PingEvent)
+
+/** Events of task two */
+enum class PongEvent : uint8_t
+{
+  Pong = 0,
+};
+
+/** Message sent by task two to task one with each ping */
+struct Score
+{
+  uint32_t u32Rounds;
+};
+
+typedef rtcos::Task<0, PingEvent, Score> TaskOne;
+typedef rtcos::Task<1, PongEvent> TaskTwo;
+
+/** Handler of task one, its state lives in the function object instead of static variables */
+struct PingHandler
+{
+  uint32_t u32Pings;
+
+  TaskOne::Events operator()(TaskOne::Events stEvents, uint8_t u08MsgCount)
+  {
+    Score *pstScore;
+
+    (void)u08MsgCount;
+    while(nullptr != (pstScore = TaskOne::receive()))
+    {
+      printf("Task one received the score: %lu rounds\r\n", (unsigned long)pstScore->u32Rounds);
+    }
+    if(stEvents.has(PingEvent::Ping))
+    {
+      printf("Task one received PING event!\r\n");
+      ++u32Pings;
+      TaskTwo::send(PongEvent::Pong, PING_PONG_DELAY_TICKS);
+    }
+    if(stEvents.has(PingEvent::Stop))
+    {
+      printf("Task one stopped after %lu pings\r\n", (unsigned long)u32Pings);
+    }
+    return stEvents.without(PingEvent::Ping | PingEvent::Stop);
+  }
+};
+
+/** Handler of task two */
+struct PongHandler
+{
+  Score stScore;
+
+  TaskTwo::Events operator()(TaskTwo::Events stEvents, uint8_t u08MsgCount)
+  {
+    (void)u08MsgCount;
+    if(stEvents.has(PongEvent::Pong))
+    {
+      printf("Task two received PONG event!\r\n");
+      /* The score is read by task one before this handler runs again */
+      ++stScore.u32Rounds;
+      TaskOne::sendMessage(&stScore);
+      TaskOne::send((stScore.u32Rounds < PING_PONG_ROUNDS) ? PingEvent::Ping : PingEvent::Stop,
+                    PING_PONG_DELAY_TICKS);
+    }
+    return stEvents.without(PongEvent::Pong);
+  }
+};
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static PingHandler stPingHandler = { 0 };
+static PongHandler stPongHandler = { { 0 } };
+
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Return nothing
+  ********************************************************************************************** */
+int main(void)
+{
+  rtcos_init();
+  /* 1 ms tick from a timerfd, rtcos_run blocks in the idle handler while nothing is ready */
+  rtcos_posix_init(TICK_PERIOD_US);
+
+  TaskOne::registerHandler(stPingHandler);
+  TaskTwo::registerHandler(stPongHandler);
+
+  TaskOne::send(PingEvent::Ping);
+
+  rtcos_run();
+  return 0;
+}
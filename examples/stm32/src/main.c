@@ -46,7 +46,7 @@ static void _on_os_timer_expired(void const *pvArg);
 /*-----------------------------------------------------------------------------------------------*/
 static uint32_t u32LedToggleCount;
 static uint32_t u32ButtonPressCount;
-static uint8_t u08OsTimerID;
+static rtcos_timer_id_t sOsTimerID;
 
 /*-----------------------------------------------------------------------------------------------*/
 /* Exported functions                                                                            */
@@ -72,8 +72,8 @@ int main(void)
   rtcos_register_task_handler(_task_two_handler, TASK_ID_PRIORITY_TWO, (void *)"TaskTwo");
 
   rtcos_send_event(TASK_ID_PRIORITY_ONE, EVENT_PING, (uint32_t)0, false);
-  u08OsTimerID = rtcos_create_timer(RTCOS_TIMER_PERIODIC, _on_os_timer_expired, (void *)"blink");
-  rtcos_start_timer(u08OsTimerID, SOFTWARE_TIMER_PERIOD_IN_MS);
+  sOsTimerID = rtcos_create_timer(RTCOS_TIMER_PERIODIC, _on_os_timer_expired, (void *)"blink");
+  rtcos_start_timer(sOsTimerID, SOFTWARE_TIMER_PERIOD_IN_MS);
   rtcos_broadcast_event(EVENT_COMMON, 0, false);
   rtcos_broadcast_message((void *)"Hello");
   rtcos_run();
@@ -12,6 +12,12 @@
 #ifndef RTCOS_CONFIG_H
 #define RTCOS_CONFIG_H
 
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+/* The POSIX port provides the critical section, the wakeup hook and enables the tickless mode */
+#include "rtcos_port.h"
+
 /*-----------------------------------------------------------------------------------------------*/
 /* Defines                                                                                       */
 /*-----------------------------------------------------------------------------------------------*/
@@ -23,10 +29,4 @@
 #define RTCOS_MAX_MESSAGES_COUNT                 2
 #define RTCOS_MAX_TIMERS_COUNT                   2
 
-/*-----------------------------------------------------------------------------------------------*/
-/* Macros                                                                                        */
-/*-----------------------------------------------------------------------------------------------*/
-#define RTCOS_ENTER_CRITICAL_SECTION()
-#define RTCOS_EXIT_CRITICAL_SECTION()
-
 #endif /* RTCOS_CONFIG_H */
@@ -13,8 +13,7 @@
 /* Includes                                                                                      */
 /*-----------------------------------------------------------------------------------------------*/
 #include <stdio.h>
-#include <time.h>
-#include "rtcos.h"
+#include "rtcos_posix.h"
 
 /*-----------------------------------------------------------------------------------------------*/
 /* Defines                                                                                       */
@@ -24,11 +23,12 @@
 #define EVENT_PING                               (uint32_t)1
 #define EVENT_PONG                               (uint32_t)2
 #define EVENT_COMMON                             (uint32_t)3
+#define TICK_PERIOD_US                           1000uL
+#define PING_PONG_DELAY_TICKS                    1000uL
 
 /*-----------------------------------------------------------------------------------------------*/
 /* Private function prototypes                                                                   */
 /*-----------------------------------------------------------------------------------------------*/
-static void delay(uint32_t u32Seconds);
 static uint32_t _task_one_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
 static uint32_t _task_two_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
 
@@ -39,6 +39,8 @@ static uint32_t _task_two_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, v
 int main(void)
 {
   rtcos_init();
+  /* 1 ms tick from a timerfd, rtcos_run blocks in the idle handler while nothing is ready */
+  rtcos_posix_init(TICK_PERIOD_US);
 
   rtcos_register_task_handler(_task_one_handler, TASK_ID_PRIORITY_ONE, (void *)"TaskOne");
   rtcos_register_task_handler(_task_two_handler, TASK_ID_PRIORITY_TWO, (void *)"TaskTwo");
@@ -76,8 +78,8 @@ static uint32_t _task_one_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, v
      * otherwise a higher priority task might be kept from running.
      */
     printf("Task one received PING event!\r\n");
-    /* Send immediate pong event to task two */
-    rtcos_send_event(TASK_ID_PRIORITY_TWO, EVENT_PONG, 0, false);
+    /* Send pong event to task two in one second */
+    rtcos_send_event(TASK_ID_PRIORITY_TWO, EVENT_PONG, PING_PONG_DELAY_TICKS, false);
     /* Return the events that have NOT been handled */
     u32RetVal = u32EventFlags & ~EVENT_PING;
   }
@@ -94,8 +96,6 @@ static uint32_t _task_one_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, v
       printf("Task one received a broadcasted message: %s\r\n", pcMessage);
     }
   }
-  /* This delay is added only for testing purposes under x86 */
-  delay(1000);
   return u32RetVal;
 }
 
@@ -110,6 +110,9 @@ static uint32_t _task_two_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, v
 {
   uint32_t u32RetVal;
   char *pcMessage;
+#ifdef RTCOS_ENABLE_STATS
+  rtcos_task_stats_t stStats;
+#endif /* RTCOS_ENABLE_STATS */
 
   u32RetVal = 0;
   printf("Task two argument is: %s\r\n", (char *)pvArg);
@@ -124,8 +127,16 @@ static uint32_t _task_two_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, v
      * otherwise a higher priority task might be kept from running.
      */
     printf("Task two received PONG event!\r\n");
-    /* Send immediate ping event to task one */
-    rtcos_send_event(TASK_ID_PRIORITY_ONE, EVENT_PING, 0, false);
+#ifdef RTCOS_ENABLE_STATS
+    if(RTCOS_ERR_NONE == rtcos_get_task_stats(TASK_ID_PRIORITY_ONE, &stStats))
+    {
+      printf("Task one ran %lu times for %lu ns (max %lu ns), CPU load is %u %%\r\n",
+             (unsigned long)stStats.u32DispatchCount, (unsigned long)stStats.u64TotalRunTime,
+             (unsigned long)stStats.u32MaxRunTime, (unsigned)rtcos_get_cpu_load());
+    }
+#endif /* RTCOS_ENABLE_STATS */
+    /* Send ping event to task one in one second */
+    rtcos_send_event(TASK_ID_PRIORITY_ONE, EVENT_PING, PING_PONG_DELAY_TICKS, false);
     /* Return the events that have NOT been handled */
     u32RetVal = u32EventFlags & ~EVENT_PONG;
   }
@@ -142,22 +153,5 @@ static uint32_t _task_two_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, v
       printf("Task two received a broadcasted message: %s\r\n", pcMessage);
     }
   }
-  /* This delay is added only for testing purposes under x86 */
-  delay(1000);
   return u32RetVal;
 }
-
-/** ***********************************************************************************************
-  * @brief      Block for a certain time
-  * @param      u32Seconds Number of seconds to wait
-  * @return     Return unhandled events
-  ********************************************************************************************** */
-static void delay(uint32_t u32Seconds)
-{
-  uint32_t u32MilliSeconds;
-  clock_t s32StartTime;
-  
-  u32MilliSeconds = 1000 * u32Seconds;
-  s32StartTime = clock();
-  while(clock() < s32StartTime + u32MilliSeconds);
-}
@@ -21,8 +21,122 @@
 /*-----------------------------------------------------------------------------------------------*/
 /* Defines                                                                                       */
 /*-----------------------------------------------------------------------------------------------*/
-/** System default configuration if no user configuration is specified */
+/** RTCOS_ENABLE_MESSAGE_POOLS adds rtcos_msg_alloc() and rtcos_msg_release(): messages taken from
+  * the fixed-block pools carry a reference count, sending one gives a reference to the receiver
+  * so that a broadcast shares a single buffer, which goes back to its pool on the last release */
+#if defined(RTCOS_ENABLE_MESSAGE_POOLS) && !defined(RTCOS_ENABLE_MESSAGES)
+#define RTCOS_ENABLE_MESSAGES
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+
+/** RTCOS_ENABLE_LOCKFREE_MESSAGES replaces the regular message fifos with lock-free rings that
+  * need C11 atomics, RTCOS_MAX_MESSAGES_COUNT must then be a power of two, define
+  * RTCOS_LOCKFREE_SINGLE_PRODUCER when each task receives messages from one context only */
+#if defined(RTCOS_ENABLE_LOCKFREE_MESSAGES) && !defined(RTCOS_ENABLE_MESSAGES)
+#define RTCOS_ENABLE_MESSAGES
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+
+/** RTCOS_ENABLE_MESSAGE_RINGS gives each task a ring of RTCOS_MESSAGE_RING_SIZE bytes holding
+  * variable-length messages inline: a producer reserves room with rtcos_ring_reserve(), writes its
+  * message in place and publishes it with rtcos_ring_commit(), the task reads it in place with
+  * rtcos_ring_read() and frees it with rtcos_ring_release(). A message holds at most
+  * RTCOS_MESSAGE_RING_SIZE - 4 bytes and its commit may not exceed its reservation. Only the
+  * bookkeeping takes the critical section, the payload is never copied by RTCOS */
+
+/** RTCOS_ENABLE_ISR_EVENTS makes the task event flags C11 atomics: immediate events are posted with
+  * a fetch-or and never mask interrupts, rtcos_send_event_from_isr() and
+  * rtcos_clear_event_from_isr() can then be called from any interrupt or host thread */
+
+/** RTCOS_ENABLE_EVENT_COUNTS counts the posts of the events selected with
+  * rtcos_set_counted_events() instead of merging them into one flag, so that a burst posted
+  * before the task runs is handled in one call: the handler reads the number of posts of each
+  * event with rtcos_get_event_count(). Counts saturate at 255 and follow unhandled events */
+
+/** RTCOS_ENABLE_STATIC_TASKS replaces rtcos_register_task_handler() with a const task table built
+  * at compile time with RTCOS_TASK_TABLE_BEGIN, RTCOS_TASK_DEFINE() and RTCOS_TASK_TABLE_END: the
+  * handlers and arguments stay in read-only memory and only the state of the tasks uses RAM. The
+  * table is global, so it is not available with RTCOS_ENABLE_INSTANCES */
+
+/** RTCOS_ENABLE_TASK_PRIORITIES gives each task a priority level that is no longer its ID,
+  * 0 being the highest, out of RTCOS_PRIORITY_LEVELS_COUNT levels. Tasks may share a level, the
+  * lowest ID then goes first. The level is given with rtcos_register_task_handler_priority() or
+  * changed at run time with rtcos_set_task_priority(), a task registered without one keeps its ID
+  * as level, or the lowest level past RTCOS_PRIORITY_LEVELS_COUNT */
+
+/** RTCOS_ENABLE_FAIR_SCHEDULING keeps busy tasks from starving the others: ready tasks sharing a
+  * priority level with RTCOS_ENABLE_TASK_PRIORITIES take turns, and a task left ready for
+  * RTCOS_AGING_TICKS ticks runs before any other, the longest waiting one first. The boost lasts
+  * until the task is dispatched, even if its priority changes meanwhile. rtcos_get_task_max_wait()
+  * gives the longest wait of each task, it is not available with RTCOS_ENABLE_WORKERS */
+
+/** RTCOS_ENABLE_EDF_SCHEDULING dispatches the ready task with the earliest deadline first. Work
+  * reaching a task with no deadline pending is due the relative deadline set with
+  * rtcos_set_task_deadline(), rtcos_send_event_deadline() posts an event with its own deadline.
+  * Tasks without a deadline run in priority order when no deadline is pending, and a handler that
+  * returns after its deadline tick counts a miss read by rtcos_get_deadline_misses(). The lookup
+  * scans the tasks having a deadline, it is not available with RTCOS_ENABLE_WORKERS or
+  * RTCOS_ENABLE_FAIR_SCHEDULING */
+
+/** RTCOS_ENABLE_TASK_BUDGETS times every handler call against the execution budget given to its
+  * task with rtcos_set_task_budget(): a call that runs longer is an overrun, it is counted along
+  * with the events it handled and reported to RTCOS_PORT_BUDGET_OVERRUN(). It needs
+  * RTCOS_PORT_TIMESTAMP() */
+
+/** RTCOS_ENABLE_TIMER_HANDLES makes the timer IDs 16 bits handles carrying a generation above
+  * the slot index, so that a handle kept after rtcos_delete_timer() gets RTCOS_ERR_NOT_FOUND
+  * instead of reaching the next timer created in its slot. Without it an ID is the 8 bits slot
+  * index. Before enabling it, store every ID in a rtcos_timer_id_t: an int8_t or uint8_t copy
+  * still compiles but loses the generation, and the calls made with it fail */
+
+/** RTCOS_ENABLE_TIMING_WHEEL schedules the future events and the timers on a hierarchical timing
+  * wheel of RTCOS_TIMING_WHEEL_LEVELS levels, so that a tick only visits what expires on it
+  * instead of scanning every pending event and running timer */
+
+/** RTCOS_ENABLE_DEFERRED_TICK makes rtcos_update_tick() only count the tick: the expiries are
+  * processed by the scheduler as a timer service at RTCOS_TIMER_SERVICE_PRIORITY, so that no timer
+  * callback runs in the tick interrupt. It is not available with RTCOS_ENABLE_WORKERS */
+
+/** RTCOS_ENABLE_TICKLESS lets the idle handler sleep until the next expiry: the ticks to the
+  * earliest future event or timer are given to RTCOS_PORT_SET_WAKEUP() and by
+  * rtcos_get_ticks_to_next_deadline(), rtcos_advance_ticks() then catches the slept ticks up */
+
+/** RTCOS_ENABLE_TIME64 counts the wraps of the system tick count so that
+  * rtcos_get_tick_count64() never wraps, and rtcos_get_timestamp() adds RTCOS_PORT_SUBTICK() to
+  * it for a resolution finer than a tick. Both read the time through a sequence counter instead
+  * of masking interrupts, rtcos_get_tick_count() then does the same. It needs C11 atomics */
+
+/** RTCOS_ENABLE_STATS records the dispatch count, handler times, delivered events and consumed
+  * messages of every task and the busy and idle time of the scheduler, the port must then define
+  * RTCOS_PORT_TIMESTAMP(). The statistics use C11 atomics so that they can be read without locks */
+
+/** RTCOS_ENABLE_TRACE records event posts, message pushes and pops, dispatches, tick processing,
+  * timer callbacks and idle periods as timestamped binary records in a RAM ring buffer,
+  * it also needs RTCOS_PORT_TIMESTAMP(). tools/trace turns a dump of the buffer into a trace
+  * that Perfetto or chrome://tracing can open */
+
+/** RTCOS_ENABLE_INSTANCES runs up to RTCOS_MAX_INSTANCES_COUNT independent schedulers in one
+  * process, e.g. one per core, per subsystem or per test. rtcos_create() hands out an instance,
+  * rtcos_destroy() gives a stopped one back for reuse, and the rtcos_*_r() functions take the
+  * instance they act on. The other functions act on the instance bound to the calling thread with
+  * rtcos_bind(), the default instance unless told otherwise, so task handlers keep using them
+  * unchanged. It needs C11 thread-local storage. Limits: an interrupt or signal handler runs bound
+  * to the instance of the thread it interrupted, so it must use the _r functions such as
+  * rtcos_send_event_from_isr_r(); RTCOS_ENTER_CRITICAL_SECTION(), the other port hooks and the
+  * trace buffer are shared by all instances, so one instance masking interrupts blocks them all */
+
+/** RTCOS_ENABLE_WORKERS runs the task handlers on a pool of RTCOS_WORKERS_COUNT POSIX threads,
+  * it is meant for Linux hosts and relies on the atomic event flags and lock-free message rings,
+  * the critical section macros must then be backed by a mutex. It comes last since it checks
+  * RTCOS_ENABLE_MESSAGES, which the message options above may enable */
+#ifdef RTCOS_ENABLE_WORKERS
+#ifndef RTCOS_ENABLE_ISR_EVENTS
+#define RTCOS_ENABLE_ISR_EVENTS
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+#if defined(RTCOS_ENABLE_MESSAGES) && !defined(RTCOS_ENABLE_LOCKFREE_MESSAGES)
+#define RTCOS_ENABLE_LOCKFREE_MESSAGES
+#endif /* RTCOS_ENABLE_MESSAGES */
+#endif /* RTCOS_ENABLE_WORKERS */
 
+/** System default configuration if no user configuration is specified */
 #ifndef RTCOS_MAX_TASKS_COUNT
 #define RTCOS_MAX_TASKS_COUNT                    2
 #endif /* RTCOS_MAX_TASKS_COUNT */
@@ -39,6 +153,72 @@
 #define RTCOS_MAX_TIMERS_COUNT                   2
 #endif /* RTCOS_MAX_TIMERS_COUNT */
 
+/** Size classes of the message pools as X(block size in bytes, blocks count), smallest first */
+#ifndef RTCOS_MESSAGE_POOLS
+#define RTCOS_MESSAGE_POOLS(X)                   X(16, 8) X(64, 4) X(256, 2)
+#endif /* RTCOS_MESSAGE_POOLS */
+
+/** Size in bytes of the message ring of each task with RTCOS_ENABLE_MESSAGE_RINGS, a multiple of 4,
+  * each message takes 4 bytes of header and is padded to 4 bytes */
+#ifndef RTCOS_MESSAGE_RING_SIZE
+#define RTCOS_MESSAGE_RING_SIZE                  256
+#endif /* RTCOS_MESSAGE_RING_SIZE */
+
+/** Number of priority levels with RTCOS_ENABLE_TASK_PRIORITIES, up to 32 */
+#ifndef RTCOS_PRIORITY_LEVELS_COUNT
+#define RTCOS_PRIORITY_LEVELS_COUNT              32
+#endif /* RTCOS_PRIORITY_LEVELS_COUNT */
+
+/** Ticks a task may stay ready before it is boosted with RTCOS_ENABLE_FAIR_SCHEDULING, 0 disables
+  * the aging */
+#ifndef RTCOS_AGING_TICKS
+#define RTCOS_AGING_TICKS                        100
+#endif /* RTCOS_AGING_TICKS */
+
+/** Timing wheel geometry used when RTCOS_ENABLE_TIMING_WHEEL is defined: 2^SLOT_BITS slots per
+  * level, the wheel covers 2^(SLOT_BITS * LEVELS) ticks without re-insertion */
+#ifndef RTCOS_TIMING_WHEEL_SLOT_BITS
+#define RTCOS_TIMING_WHEEL_SLOT_BITS             5
+#endif /* RTCOS_TIMING_WHEEL_SLOT_BITS */
+
+#ifndef RTCOS_TIMING_WHEEL_LEVELS
+#define RTCOS_TIMING_WHEEL_LEVELS                4
+#endif /* RTCOS_TIMING_WHEEL_LEVELS */
+
+/** With RTCOS_ENABLE_DEFERRED_TICK the timer service preempts the tasks whose priority level,
+  * the task ID by default, is greater than or equal to this value, 0 processes the expiries
+  * before any task */
+#ifndef RTCOS_TIMER_SERVICE_PRIORITY
+#define RTCOS_TIMER_SERVICE_PRIORITY             0
+#endif /* RTCOS_TIMER_SERVICE_PRIORITY */
+
+/** Number of RTCOS_PORT_SUBTICK() units in a tick with RTCOS_ENABLE_TIME64, 1 when the port has
+  * no sub-tick counter */
+#ifndef RTCOS_SUBTICKS_PER_TICK
+#define RTCOS_SUBTICKS_PER_TICK                  1
+#endif /* RTCOS_SUBTICKS_PER_TICK */
+
+/** Number of records kept by the trace ring buffer, a power of two, each record takes 12 bytes */
+#ifndef RTCOS_TRACE_RECORDS_COUNT
+#define RTCOS_TRACE_RECORDS_COUNT                256
+#endif /* RTCOS_TRACE_RECORDS_COUNT */
+
+/** Number of scheduler instances with RTCOS_ENABLE_INSTANCES, the default instance included */
+#ifndef RTCOS_MAX_INSTANCES_COUNT
+#define RTCOS_MAX_INSTANCES_COUNT                4
+#endif /* RTCOS_MAX_INSTANCES_COUNT */
+
+/** Number of worker threads used with RTCOS_ENABLE_WORKERS, rtcos_run() is the first of them */
+#ifndef RTCOS_WORKERS_COUNT
+#define RTCOS_WORKERS_COUNT                      4
+#endif /* RTCOS_WORKERS_COUNT */
+
+/** Each worker keeps one deque per priority band, tasks are split in bands by ID so that
+  * higher priority tasks are popped and stolen first */
+#ifndef RTCOS_WORKER_PRIORITY_BANDS
+#define RTCOS_WORKER_PRIORITY_BANDS              4
+#endif /* RTCOS_WORKER_PRIORITY_BANDS */
+
 /*-----------------------------------------------------------------------------------------------*/
 /* Macros                                                                                        */
 /*-----------------------------------------------------------------------------------------------*/
@@ -50,4 +230,33 @@
 #define RTCOS_EXIT_CRITICAL_SECTION()
 #endif /* RTCOS_EXIT_CRITICAL_SECTION */
 
+/** Called with RTCOS_ENABLE_TICKLESS right before the idle handler to program a one shot wakeup,
+  * the argument is the number of ticks to the next deadline or RTCOS_NO_DEADLINE */
+#ifndef RTCOS_PORT_SET_WAKEUP
+#define RTCOS_PORT_SET_WAKEUP(u32Ticks)
+#endif /* RTCOS_PORT_SET_WAKEUP */
+
+/** Called each time a task becomes ready, from any context, so that a port whose idle handler
+  * blocks can wake the scheduler up */
+#ifndef RTCOS_PORT_WAKEUP
+#define RTCOS_PORT_WAKEUP()
+#endif /* RTCOS_PORT_WAKEUP */
+
+/** Called with RTCOS_ENABLE_TASK_BUDGETS from the scheduler context after a handler call that
+  * exceeded the budget of its task, with the events it handled and its run time */
+#ifndef RTCOS_PORT_BUDGET_OVERRUN
+#define RTCOS_PORT_BUDGET_OVERRUN(u08TaskID, u32EventFlags, u32RunTime)
+#endif /* RTCOS_PORT_BUDGET_OVERRUN */
+
+/** Returns with RTCOS_ENABLE_TIME64 the time elapsed since the last tick in units of
+  * 1/RTCOS_SUBTICKS_PER_TICK tick, e.g. the reload value minus the SysTick counter on a Cortex-M */
+#ifndef RTCOS_PORT_SUBTICK
+#define RTCOS_PORT_SUBTICK()                     0
+#endif /* RTCOS_PORT_SUBTICK */
+
+/** RTCOS_PORT_TIMESTAMP() has no default, with RTCOS_ENABLE_STATS, RTCOS_ENABLE_TRACE or
+  * RTCOS_ENABLE_TASK_BUDGETS it must return a free running 32 bits cycle or time counter, e.g. the
+  * DWT cycle counter on a Cortex-M, which must not wrap more than once during a handler call or
+  * an idle period */
+
 #endif /* CONFIG_H */
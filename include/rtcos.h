@@ -27,6 +27,38 @@
 #define NULL                                     0x00000000uL
 #endif /* NULL */
 
+#ifdef RTCOS_ENABLE_TICKLESS
+/** Returned by rtcos_get_ticks_to_next_deadline() when no event nor timer is pending */
+#define RTCOS_NO_DEADLINE                        0xFFFFFFFFuL
+#endif /* RTCOS_ENABLE_TICKLESS */
+
+#ifdef RTCOS_ENABLE_STATIC_TASKS
+/** Build the task table at compile time, once in a source file of the application:
+  *   RTCOS_TASK_TABLE_BEGIN
+  *     RTCOS_TASK_DEFINE(_on_uart_event, &stUart),
+  *     RTCOS_TASK_DEFINE(_on_led_event, NULL),
+  *   RTCOS_TASK_TABLE_END;
+  * The position of an entry is the ID of its task. The table is const so that the linker can place
+  * it in read-only memory, it must not hold more than RTCOS_MAX_TASKS_COUNT entries. An entry
+  * whose handler is NULL reserves its ID: events and messages sent to it are rejected with
+  * RTCOS_ERR_INVALID_TASK and broadcasts skip it, the entries after it are still tasks */
+#define RTCOS_TASK_TABLE_BEGIN                                                                    \
+  const rtcos_task_def_t RTCOS_tstStaticTasks[] = {
+#define RTCOS_TASK_DEFINE(pfTaskHandler, pvArg)  { (pfTaskHandler), (pvArg) }
+#define RTCOS_TASK_TABLE_END                                                                      \
+  };                                                                                              \
+  const uint8_t RTCOS_u08StaticTasksCount =                                                       \
+    (uint8_t)(sizeof(RTCOS_tstStaticTasks) / sizeof(RTCOS_tstStaticTasks[0]));                    \
+  typedef char rtcos_static_tasks_fit_t[((sizeof(RTCOS_tstStaticTasks) /                          \
+                                          sizeof(RTCOS_tstStaticTasks[0])) <=                     \
+                                         RTCOS_MAX_TASKS_COUNT) ? 1 : -1]
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+
+#ifdef RTCOS_ENABLE_TRACE
+/** Task ID of the trace records that are not related to a task */
+#define RTCOS_TRACE_NO_TASK                      (uint8_t)0xFF
+#endif /* RTCOS_ENABLE_TRACE */
+
 /*-----------------------------------------------------------------------------------------------*/
 /* Types                                                                                         */
 /*-----------------------------------------------------------------------------------------------*/
@@ -36,9 +68,22 @@ typedef void (*pf_os_idle_handler_t)(void);
 /** A callback function to execute when an OS timer expires */
 typedef void (*pf_os_timer_cb_t)(void const *);
 #endif /* RTCOS_ENABLE_TIMERS */
+#ifdef RTCOS_ENABLE_INSTANCES
+/** A scheduler instance, its content is private to RTCOS */
+typedef struct rtcos_main rtcos_t;
+#endif /* RTCOS_ENABLE_INSTANCES */
 /** A task handler function to execute when the task receives an event or a message */
 typedef uint32_t (*pf_os_task_handler_t)(uint32_t, uint8_t, void const *);
 
+#ifdef RTCOS_ENABLE_STATIC_TASKS
+/** Entry of the static task table built with RTCOS_TASK_DEFINE() */
+typedef struct
+{
+  pf_os_task_handler_t pfTaskHandlerCb;          /**< Task handler function                      */
+  void const *pvArg;                             /**< Task argument                              */
+}rtcos_task_def_t;
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+
 typedef enum
 {
   RTCOS_ERR_NONE             = 0,
@@ -52,14 +97,74 @@ typedef enum
   RTCOS_ERR_MSG_FULL         = -8,
   RTCOS_ERR_MSG_EMPTY        = -9,
   RTCOS_ERR_ARG              = -10,
+  RTCOS_ERR_INVALID_MSG      = -11,
 }rtcos_status_t;
 
+#ifdef RTCOS_ENABLE_STATS
+/** Runtime statistics of a task, times are in RTCOS_PORT_TIMESTAMP() units */
+typedef struct
+{
+  uint32_t u32DispatchCount;                     /**< Number of handler calls                    */
+  uint32_t u32EventsCount;                       /**< Number of event flags delivered            */
+  uint32_t u32MessagesCount;                     /**< Number of messages consumed                */
+  uint32_t u32MaxRunTime;                        /**< Longest handler call                       */
+  uint64_t u64TotalRunTime;                      /**< Cumulative time spent in the handler       */
+}rtcos_task_stats_t;
+#endif /* RTCOS_ENABLE_STATS */
+
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+/** Budget overruns of a task, times are in RTCOS_PORT_TIMESTAMP() units */
+typedef struct
+{
+  uint32_t u32Budget;                            /**< Execution budget of a handler call, 0 none */
+  uint32_t u32OverrunsCount;                     /**< Number of handler calls over the budget    */
+  uint32_t u32LastEventFlags;                    /**< Events handled by the last overrun call    */
+  uint32_t u32LastRunTime;                       /**< Run time of the last overrun call          */
+}rtcos_task_overruns_t;
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+
+#ifdef RTCOS_ENABLE_TRACE
+/** Kind of a trace record, these values are part of the dump format read by tools/trace */
+typedef enum
+{
+  RTCOS_TRACE_EVENT_POST     = 0,                /**< Value is the posted event flags            */
+  RTCOS_TRACE_MESSAGE_PUSH   = 1,                /**< Value is the message pointer               */
+  RTCOS_TRACE_MESSAGE_POP    = 2,                /**< Value is the message pointer               */
+  RTCOS_TRACE_DISPATCH_START = 3,                /**< Value is the events given to the handler   */
+  RTCOS_TRACE_DISPATCH_END   = 4,                /**< Value is the unhandled events              */
+  RTCOS_TRACE_TICK_START     = 5,                /**< Value is the processed tick count          */
+  RTCOS_TRACE_TICK_END       = 6,                /**< Value is the processed tick count          */
+  RTCOS_TRACE_TIMER_START    = 7,                /**< Value is the ID of the timer               */
+  RTCOS_TRACE_TIMER_END      = 8,                /**< Value is the ID of the timer               */
+  RTCOS_TRACE_IDLE_ENTER     = 9,                /**< Value is unused                            */
+  RTCOS_TRACE_IDLE_EXIT      = 10,               /**< Value is unused                            */
+}rtcos_trace_kind_t;
+
+/** Binary trace record, times are in RTCOS_PORT_TIMESTAMP() units */
+typedef struct
+{
+  uint32_t u32Timestamp;                         /**< Time at which the record was written       */
+  uint32_t u32Value;                             /**< Depends on the kind of the record          */
+  uint16_t u16Sequence;                          /**< Low bits of the record position            */
+  uint8_t u08Kind;                               /**< As defined in ::rtcos_trace_kind_t         */
+  uint8_t u08TaskID;                             /**< Related task or RTCOS_TRACE_NO_TASK        */
+}rtcos_trace_record_t;
+#endif /* RTCOS_ENABLE_TRACE */
+
 #ifdef RTCOS_ENABLE_TIMERS
 typedef enum
 {
   RTCOS_TIMER_PERIODIC       = 0,
   RTCOS_TIMER_ONE_SHOT,
 }rtcos_timer_type_t;
+
+/** Handle of an OS timer, a negative value is a ::rtcos_status_t error code. It is the 8 bits
+  * slot index unless RTCOS_ENABLE_TIMER_HANDLES adds a generation above it */
+#ifdef RTCOS_ENABLE_TIMER_HANDLES
+typedef int16_t rtcos_timer_id_t;
+#else
+typedef int8_t rtcos_timer_id_t;
+#endif /* RTCOS_ENABLE_TIMER_HANDLES */
 #endif /* RTCOS_ENABLE_TIMERS */
 
 /*-----------------------------------------------------------------------------------------------*/
@@ -70,28 +175,123 @@ extern "C"
 {
 #endif /* __cplusplus */
 
+#ifdef RTCOS_ENABLE_STATIC_TASKS
+/** Defined by RTCOS_TASK_TABLE_BEGIN and RTCOS_TASK_TABLE_END */
+extern const rtcos_task_def_t RTCOS_tstStaticTasks[];
+extern const uint8_t RTCOS_u08StaticTasksCount;
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+
 void rtcos_init(void);
 void rtcos_run(void);
 void rtcos_delay(uint32_t);
 void rtcos_update_tick(void);
 void rtcos_set_tick_count(uint32_t);
 uint32_t rtcos_get_tick_count(void);
+uint8_t rtcos_get_current_task(void);
+#ifdef RTCOS_ENABLE_TIME64
+uint64_t rtcos_get_tick_count64(void);
+uint64_t rtcos_get_timestamp(void);
+#endif /* RTCOS_ENABLE_TIME64 */
+#ifdef RTCOS_ENABLE_TICKLESS
+uint32_t rtcos_get_ticks_to_next_deadline(void);
+void rtcos_advance_ticks(uint32_t);
+#endif /* RTCOS_ENABLE_TICKLESS */
 #ifdef RTCOS_ENABLE_TIMERS
-int8_t rtcos_create_timer(rtcos_timer_type_t, pf_os_timer_cb_t, void *);
-bool rtcos_timer_expired(uint8_t);
-rtcos_status_t rtcos_start_timer(uint8_t, uint32_t);
-rtcos_status_t rtcos_stop_timer(uint8_t);
+/** The timers expiring on the same tick are called in no guaranteed order, not in ID order: the
+  * last started one comes first on the list of running timers, and the timing wheel calls them in
+  * the order of their slot. A callback needing another one to run first must not share its tick */
+rtcos_timer_id_t rtcos_create_timer(rtcos_timer_type_t, pf_os_timer_cb_t, void *);
+rtcos_status_t rtcos_delete_timer(rtcos_timer_id_t);
+bool rtcos_timer_expired(rtcos_timer_id_t);
+rtcos_status_t rtcos_start_timer(rtcos_timer_id_t, uint32_t);
+rtcos_status_t rtcos_stop_timer(rtcos_timer_id_t);
 #endif /* RTCOS_ENABLE_TIMERS */
+#ifndef RTCOS_ENABLE_STATIC_TASKS
 rtcos_status_t rtcos_register_task_handler(pf_os_task_handler_t, uint8_t,  void *);
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
 rtcos_status_t rtcos_register_idle_handler(pf_os_idle_handler_t);
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+#ifndef RTCOS_ENABLE_STATIC_TASKS
+rtcos_status_t rtcos_register_task_handler_priority(pf_os_task_handler_t, uint8_t, void *, uint8_t);
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+rtcos_status_t rtcos_set_task_priority(uint8_t, uint8_t);
+uint8_t rtcos_get_task_priority(uint8_t);
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+uint32_t rtcos_get_task_max_wait(uint8_t);
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+rtcos_status_t rtcos_set_task_deadline(uint8_t, uint32_t);
+rtcos_status_t rtcos_send_event_deadline(uint8_t, uint32_t, uint32_t);
+uint32_t rtcos_get_deadline_misses(uint8_t);
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
 rtcos_status_t rtcos_send_event(uint8_t, uint32_t, uint32_t, bool);
 rtcos_status_t rtcos_broadcast_event(uint32_t, uint32_t, bool);
 rtcos_status_t rtcos_clear_event(uint8_t, uint32_t);
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+rtcos_status_t rtcos_send_event_from_isr(uint8_t, uint32_t);
+rtcos_status_t rtcos_clear_event_from_isr(uint8_t, uint32_t);
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+rtcos_status_t rtcos_set_counted_events(uint8_t, uint32_t);
+uint8_t rtcos_get_event_count(uint32_t);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
 #ifdef RTCOS_ENABLE_MESSAGES
 rtcos_status_t rtcos_send_message(uint8_t, void *);
 rtcos_status_t rtcos_broadcast_message(void *);
+uint8_t rtcos_send_messages(uint8_t, void **, uint8_t);
 rtcos_status_t rtcos_get_message(void **);
+uint8_t rtcos_get_messages(void **, uint8_t);
+rtcos_status_t rtcos_peek_message(void **);
+#endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+void *rtcos_msg_alloc(uint16_t);
+rtcos_status_t rtcos_msg_release(void *);
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+void *rtcos_ring_reserve(uint8_t, uint16_t);
+rtcos_status_t rtcos_ring_commit(uint8_t, uint16_t);
+void const *rtcos_ring_read(uint16_t *);
+rtcos_status_t rtcos_ring_release(void);
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+#ifdef RTCOS_ENABLE_STATS
+rtcos_status_t rtcos_get_task_stats(uint8_t, rtcos_task_stats_t *);
+uint8_t rtcos_get_cpu_load(void);
+#endif /* RTCOS_ENABLE_STATS */
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+rtcos_status_t rtcos_set_task_budget(uint8_t, uint32_t);
+rtcos_status_t rtcos_get_task_overruns(uint8_t, rtcos_task_overruns_t *);
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+#ifdef RTCOS_ENABLE_TRACE
+void rtcos_enable_trace(bool);
+void const *rtcos_get_trace_buffer(uint32_t *);
+#endif /* RTCOS_ENABLE_TRACE */
+
+#ifdef RTCOS_ENABLE_INSTANCES
+/** The functions without _r act on the instance bound to the calling thread. An interrupt or a
+  * signal handler runs bound to whatever the interrupted thread uses, so it must only call the _r
+  * forms. RTCOS_ENTER_CRITICAL_SECTION() and the trace buffer are shared by all the instances */
+rtcos_t *rtcos_create(void);
+rtcos_status_t rtcos_destroy(rtcos_t *);
+rtcos_t *rtcos_get_default(void);
+rtcos_t *rtcos_bind(rtcos_t *);
+void rtcos_init_r(rtcos_t *);
+void rtcos_run_r(rtcos_t *);
+void rtcos_update_tick_r(rtcos_t *);
+uint32_t rtcos_get_tick_count_r(rtcos_t *);
+#ifndef RTCOS_ENABLE_STATIC_TASKS
+rtcos_status_t rtcos_register_task_handler_r(rtcos_t *, pf_os_task_handler_t, uint8_t, void *);
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+rtcos_status_t rtcos_register_idle_handler_r(rtcos_t *, pf_os_idle_handler_t);
+rtcos_status_t rtcos_send_event_r(rtcos_t *, uint8_t, uint32_t, uint32_t, bool);
+rtcos_status_t rtcos_clear_event_r(rtcos_t *, uint8_t, uint32_t);
+#ifdef RTCOS_ENABLE_MESSAGES
+rtcos_status_t rtcos_send_message_r(rtcos_t *, uint8_t, void *);
 #endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+rtcos_status_t rtcos_send_event_from_isr_r(rtcos_t *, uint8_t, uint32_t);
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+#endif /* RTCOS_ENABLE_INSTANCES */
 
 #if defined(__cplusplus)
 }
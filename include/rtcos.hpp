@@ -0,0 +1,200 @@
+/*
+ **************************************************************************************************
+ *
+ * @file    : rtcos.hpp
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Header-only C++11 wrapper of the RTCOS API: typed events, typed messages and
+ *            function object handlers, every call inlines to the matching C call
+ *
+ **************************************************************************************************
+ */
+#ifndef RTCOS_HPP
+#define RTCOS_HPP
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include <type_traits>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+/** Lets two events of an enum class be combined with | into a rtcos::EventSet */
+#define RTCOS_EVENT_ENUM(EventEnum)                                                               \
+  constexpr rtcos::EventSet<EventEnum> operator|(EventEnum eLeft, EventEnum eRight)               \
+  {                                                                                               \
+    return rtcos::EventSet<EventEnum>(eLeft) | eRight;                                            \
+  }
+
+namespace rtcos
+{
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Types                                                                                         */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Set of events of an enum class whose enumerators are the bit positions 0 to 31,
+  *             it holds the same 32 bits flags as the C API
+  ********************************************************************************************** */
+template<typename EventEnum>
+class EventSet
+{
+  static_assert(std::is_enum<EventEnum>::value, "events must be an enum of bit positions");
+
+public:
+  constexpr EventSet() : u32Flags(0) {}
+  constexpr EventSet(EventEnum eEvent) : u32Flags(flag(eEvent)) {}
+
+  /** Wrap raw flags coming from the C API */
+  static constexpr EventSet fromRaw(uint32_t u32RawFlags) { return EventSet(u32RawFlags, 0); }
+
+  constexpr uint32_t raw() const { return u32Flags; }
+  constexpr bool empty() const { return 0 == u32Flags; }
+  constexpr bool has(EventEnum eEvent) const { return 0 != (u32Flags & flag(eEvent)); }
+
+  constexpr EventSet operator|(EventSet stOther) const
+  {
+    return EventSet(u32Flags | stOther.u32Flags, 0);
+  }
+  constexpr EventSet operator&(EventSet stOther) const
+  {
+    return EventSet(u32Flags & stOther.u32Flags, 0);
+  }
+  /** Events of this set that are not in the other one */
+  constexpr EventSet without(EventSet stOther) const
+  {
+    return EventSet(u32Flags & ~stOther.u32Flags, 0);
+  }
+
+private:
+  constexpr EventSet(uint32_t u32RawFlags, int) : u32Flags(u32RawFlags) {}
+  static constexpr uint32_t flag(EventEnum eEvent)
+  {
+    return (static_cast<uint32_t>(eEvent) < 32u) ?
+           ((uint32_t)1 << static_cast<uint32_t>(eEvent)) : aboveBit31();
+  }
+  /** Not constexpr on purpose: a set built at compile time from an enumerator above 31 calls it
+    * and fails to compile, at run time such an enumerator maps to no flag instead of shifting past
+    * the 32 bits */
+  static uint32_t aboveBit31() { return 0; }
+
+  uint32_t u32Flags;
+};
+
+/** ***********************************************************************************************
+  * @brief      Typed view of a task. The task ID, its events and the type of its messages are
+  *             fixed at compile time, the class holds no data and all its functions are static.
+  *             A handler is a function object called as
+  *               EventSet<EventEnum> operator()(EventSet<EventEnum> stEvents, uint8_t u08MsgCount)
+  *             which returns the events it left unhandled
+  * @tparam     u08TaskID ID of the task in the C API
+  * @tparam     EventEnum enum class of the events of the task
+  * @tparam     Message Type of the messages sent to the task, void if it takes none. Every task
+  *             fifo holds RTCOS_MAX_MESSAGES_COUNT messages
+  ********************************************************************************************** */
+template<uint8_t u08TaskID, typename EventEnum, typename Message = void>
+class Task
+{
+  static_assert(u08TaskID < RTCOS_MAX_TASKS_COUNT, "task ID above RTCOS_MAX_TASKS_COUNT");
+#ifndef RTCOS_ENABLE_MESSAGES
+  static_assert(std::is_void<Message>::value, "messages need RTCOS_ENABLE_MESSAGES");
+#endif /* RTCOS_ENABLE_MESSAGES */
+
+public:
+  typedef EventSet<EventEnum> Events;
+
+  static constexpr uint8_t id() { return u08TaskID; }
+
+  /** C handler calling the function object given as task argument, it can be put in a static
+    * task table with RTCOS_TASK_DEFINE(Task::entry<Handler>, &stHandler) */
+  template<typename Handler>
+  static uint32_t entry(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+  {
+    Handler &stHandler = *static_cast<Handler *>(const_cast<void *>(pvArg));
+
+    return stHandler(Events::fromRaw(u32EventFlags), u08MsgCount).raw();
+  }
+
+#ifndef RTCOS_ENABLE_STATIC_TASKS
+  /** The handler is referenced, not copied: it must outlive the scheduler */
+  template<typename Handler>
+  static rtcos_status_t registerHandler(Handler &stHandler)
+  {
+    return rtcos_register_task_handler(&entry<Handler>, u08TaskID, &stHandler);
+  }
+
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+  template<typename Handler>
+  static rtcos_status_t registerHandler(Handler &stHandler, uint8_t u08Priority)
+  {
+    return rtcos_register_task_handler_priority(&entry<Handler>, u08TaskID, &stHandler,
+                                                u08Priority);
+  }
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+
+  static rtcos_status_t send(Events stEvents, uint32_t u32Delay = 0, bool bPeriodic = false)
+  {
+    return rtcos_send_event(u08TaskID, stEvents.raw(), u32Delay, bPeriodic);
+  }
+
+  static rtcos_status_t clear(Events stEvents)
+  {
+    return rtcos_clear_event(u08TaskID, stEvents.raw());
+  }
+
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+  static rtcos_status_t sendFromIsr(Events stEvents)
+  {
+    return rtcos_send_event_from_isr(u08TaskID, stEvents.raw());
+  }
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+  static rtcos_status_t countEvents(Events stEvents)
+  {
+    return rtcos_set_counted_events(u08TaskID, stEvents.raw());
+  }
+
+  /** Number of posts of an event for the running handler call */
+  static uint8_t eventCount(EventEnum eEvent)
+  {
+    return rtcos_get_event_count(Events(eEvent).raw());
+  }
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+
+#ifdef RTCOS_ENABLE_MESSAGES
+  /** The message is passed by reference and must stay valid until the task has consumed it */
+  static rtcos_status_t sendMessage(Message *pMessage)
+  {
+    return rtcos_send_message(u08TaskID, pMessage);
+  }
+
+  /** Take the next message of this task, nullptr if there is none or if the running handler is
+    * not the one of this task: the fifo read is the one of the running task */
+  static Message *receive()
+  {
+    void *pvMessage;
+
+    return ((u08TaskID == rtcos_get_current_task()) &&
+            (RTCOS_ERR_NONE == rtcos_get_message(&pvMessage))) ?
+           static_cast<Message *>(pvMessage) : nullptr;
+  }
+
+  /** Read the next message of this task without taking it, nullptr as for receive() */
+  static Message *peek()
+  {
+    void *pvMessage;
+
+    return ((u08TaskID == rtcos_get_current_task()) &&
+            (RTCOS_ERR_NONE == rtcos_peek_message(&pvMessage))) ?
+           static_cast<Message *>(pvMessage) : nullptr;
+  }
+#endif /* RTCOS_ENABLE_MESSAGES */
+};
+
+} /* namespace rtcos */
+
+#endif /* RTCOS_HPP */
@@ -0,0 +1,53 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : rtcos_port.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS POSIX port hooks, include it from RTCOSConfig.h
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_PORT_H
+#define RTCOS_PORT_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+/** The idle handler of the port blocks, it must also be called while future events are pending */
+#ifndef RTCOS_ENABLE_TICKLESS
+#define RTCOS_ENABLE_TICKLESS
+#endif /* RTCOS_ENABLE_TICKLESS */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Functions                                                                                     */
+/*-----------------------------------------------------------------------------------------------*/
+#if defined(__cplusplus)
+extern "C"
+{
+#endif /* __cplusplus */
+
+void rtcos_posix_enter_critical_section(void);
+void rtcos_posix_exit_critical_section(void);
+void rtcos_posix_wakeup(void);
+uint32_t rtcos_posix_timestamp(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()           rtcos_posix_enter_critical_section();
+#define RTCOS_EXIT_CRITICAL_SECTION()            rtcos_posix_exit_critical_section();
+#define RTCOS_PORT_WAKEUP()                      rtcos_posix_wakeup();
+#define RTCOS_PORT_TIMESTAMP()                   rtcos_posix_timestamp()
+
+#endif /* RTCOS_PORT_H */
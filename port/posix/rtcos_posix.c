@@ -0,0 +1,290 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : rtcos_posix.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS POSIX port: the tick comes from a thread reading a timerfd (clock_nanosleep
+ *            outside Linux), the critical section is a recursive mutex and the idle handler
+ *            blocks on an eventfd (a pipe outside Linux) until a task becomes ready
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif /* __linux__ */
+#include "rtcos_posix.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private defines                                                                               */
+/*-----------------------------------------------------------------------------------------------*/
+/** Index of the read and write ends of the wakeup descriptor, both are the same eventfd on Linux */
+#define RTCOS_POSIX_WAKEUP_READ                  0
+#define RTCOS_POSIX_WAKEUP_WRITE                 1
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static void _rtcos_posix_idle(void);
+static void *_rtcos_posix_tick_thread(void *pvArg);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static pthread_mutex_t RTCOSi_stCriticalSection;
+static pthread_t RTCOSi_stTickThread;
+static uint32_t RTCOSi_u32TickPeriodUs;
+static int RTCOSi_ts32WakeupFd[2];
+static _Atomic bool RTCOSi_bWakeupPending;
+#ifdef __linux__
+static int RTCOSi_s32TimerFd;
+#endif /* __linux__ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported functions                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Initialize the port: critical section, wakeup descriptor, idle handler and tick
+  *             thread. Must be called after rtcos_init() and before rtcos_run().
+  * @param      u32TickPeriodUs Tick period in microseconds
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_posix_init(uint32_t u32TickPeriodUs)
+{
+  pthread_mutexattr_t stAttr;
+  rtcos_status_t eRetVal;
+#ifdef __linux__
+  struct itimerspec stPeriod;
+#endif /* __linux__ */
+
+  eRetVal = RTCOS_ERR_NONE;
+  if(0 == u32TickPeriodUs)
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    RTCOSi_u32TickPeriodUs = u32TickPeriodUs;
+    pthread_mutexattr_init(&stAttr);
+    pthread_mutexattr_settype(&stAttr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&RTCOSi_stCriticalSection, &stAttr);
+    pthread_mutexattr_destroy(&stAttr);
+    atomic_init(&RTCOSi_bWakeupPending, false);
+#ifdef __linux__
+    RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_READ] = eventfd(0, EFD_CLOEXEC);
+    RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_WRITE] = RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_READ];
+    if(RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_READ] < 0)
+#else
+    if(0 != pipe(RTCOSi_ts32WakeupFd))
+#endif /* __linux__ */
+    {
+      eRetVal = RTCOS_ERR_OUT_OF_RESOURCES;
+    }
+  }
+#ifdef __linux__
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    RTCOSi_s32TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    stPeriod.it_interval.tv_sec = u32TickPeriodUs / 1000000uL;
+    stPeriod.it_interval.tv_nsec = (long)(u32TickPeriodUs % 1000000uL) * 1000L;
+    stPeriod.it_value = stPeriod.it_interval;
+    if((RTCOSi_s32TimerFd < 0) || (0 != timerfd_settime(RTCOSi_s32TimerFd, 0, &stPeriod, NULL)))
+    {
+      eRetVal = RTCOS_ERR_OUT_OF_RESOURCES;
+    }
+  }
+#endif /* __linux__ */
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    rtcos_register_idle_handler(_rtcos_posix_idle);
+    if(0 != pthread_create(&RTCOSi_stTickThread, NULL, _rtcos_posix_tick_thread, NULL))
+    {
+      eRetVal = RTCOS_ERR_OUT_OF_RESOURCES;
+    }
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Run the calling thread, which should then call rtcos_run(), with the SCHED_FIFO
+  *             policy. The tick thread gets the next priority so that it preempts the tasks
+  *             like a timer interrupt would. Needs CAP_SYS_NICE, call after rtcos_posix_init().
+  * @param      u08Priority SCHED_FIFO priority of the calling thread
+  * @param      s16Cpu CPU both threads are pinned to or RTCOS_POSIX_ANY_CPU
+  * @return     RTCOS_ERR_ARG if the system rejects the priority or the CPU, else RTCOS_ERR_NONE
+  ********************************************************************************************** */
+rtcos_status_t rtcos_posix_set_realtime(uint8_t u08Priority, int16_t s16Cpu)
+{
+  struct sched_param stParam;
+  rtcos_status_t eRetVal;
+#ifdef __linux__
+  cpu_set_t stCpuSet;
+#endif /* __linux__ */
+
+  eRetVal = RTCOS_ERR_NONE;
+  stParam.sched_priority = u08Priority;
+  if(0 != pthread_setschedparam(pthread_self(), SCHED_FIFO, &stParam))
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  if(stParam.sched_priority < sched_get_priority_max(SCHED_FIFO))
+  {
+    ++stParam.sched_priority;
+  }
+  if(0 != pthread_setschedparam(RTCOSi_stTickThread, SCHED_FIFO, &stParam))
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+#ifdef __linux__
+  if(s16Cpu >= 0)
+  {
+    CPU_ZERO(&stCpuSet);
+    CPU_SET(s16Cpu, &stCpuSet);
+    if((0 != pthread_setaffinity_np(pthread_self(), sizeof(stCpuSet), &stCpuSet)) ||
+       (0 != pthread_setaffinity_np(RTCOSi_stTickThread, sizeof(stCpuSet), &stCpuSet)))
+    {
+      eRetVal = RTCOS_ERR_ARG;
+    }
+  }
+#else
+  if(s16Cpu >= 0)
+  {
+    /* CPU pinning is not part of POSIX */
+    eRetVal = RTCOS_ERR_ARG;
+  }
+#endif /* __linux__ */
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Enter the critical section shared by the scheduler, the tick thread and any
+  *             other thread using the RTCOS API
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_posix_enter_critical_section(void)
+{
+  pthread_mutex_lock(&RTCOSi_stCriticalSection);
+}
+
+/** ***********************************************************************************************
+  * @brief      Exit the critical section
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_posix_exit_critical_section(void)
+{
+  pthread_mutex_unlock(&RTCOSi_stCriticalSection);
+}
+
+/** ***********************************************************************************************
+  * @brief      Wake the scheduler up if it is blocked in the idle handler, called by RTCOS each
+  *             time a task becomes ready. Only the first call after a wakeup does a system call.
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_posix_wakeup(void)
+{
+#ifdef __linux__
+  uint64_t u64Value;
+#else
+  uint8_t u08Value;
+#endif /* __linux__ */
+
+  if(false == atomic_exchange_explicit(&RTCOSi_bWakeupPending, true, memory_order_acq_rel))
+  {
+#ifdef __linux__
+    u64Value = 1;
+    (void)write(RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_WRITE], &u64Value, sizeof(u64Value));
+#else
+    u08Value = 1;
+    (void)write(RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_WRITE], &u08Value, sizeof(u08Value));
+#endif /* __linux__ */
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Timestamp used by RTCOS_ENABLE_STATS, the monotonic clock in microseconds
+  *             truncated to 32 bits: it wraps every 71 minutes, far above the idle periods of
+  *             the blocking idle handler
+  * @return     Current timestamp in microseconds
+  ********************************************************************************************** */
+uint32_t rtcos_posix_timestamp(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+  return ((uint32_t)stTime.tv_sec * 1000000uL) + (uint32_t)(stTime.tv_nsec / 1000);
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Idle handler: block until rtcos_posix_wakeup() is called. A wakeup posted after
+  *             the scheduler found no ready task is still pending in the descriptor, so that
+  *             the read returns right away.
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_posix_idle(void)
+{
+#ifdef __linux__
+  uint64_t u64Value;
+
+  (void)read(RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_READ], &u64Value, sizeof(u64Value));
+#else
+  uint8_t u08Value;
+
+  (void)read(RTCOSi_ts32WakeupFd[RTCOS_POSIX_WAKEUP_READ], &u08Value, sizeof(u08Value));
+#endif /* __linux__ */
+  (void)atomic_exchange_explicit(&RTCOSi_bWakeupPending, false, memory_order_acq_rel);
+}
+
+/** ***********************************************************************************************
+  * @brief      Tick thread: plays the role of the timer interrupt. Ticks missed while the thread
+  *             was not scheduled are caught up in one rtcos_advance_ticks() call.
+  * @param      pvArg Unused
+  * @return     Never returns
+  ********************************************************************************************** */
+static void *_rtcos_posix_tick_thread(void *pvArg)
+{
+#ifdef __linux__
+  uint64_t u64Expirations;
+#else
+  struct timespec stNext;
+#endif /* __linux__ */
+
+  (void)pvArg;
+#ifndef __linux__
+  clock_gettime(CLOCK_MONOTONIC, &stNext);
+#endif /* __linux__ */
+  while(1)
+  {
+#ifdef __linux__
+    if(sizeof(u64Expirations) == read(RTCOSi_s32TimerFd, &u64Expirations, sizeof(u64Expirations)))
+    {
+      rtcos_advance_ticks((uint32_t)u64Expirations);
+#else
+    stNext.tv_nsec += (long)(RTCOSi_u32TickPeriodUs % 1000000uL) * 1000L;
+    stNext.tv_sec += (time_t)(RTCOSi_u32TickPeriodUs / 1000000uL) + (stNext.tv_nsec / 1000000000L);
+    stNext.tv_nsec %= 1000000000L;
+    if(0 == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stNext, NULL))
+    {
+      rtcos_advance_ticks(1);
+#endif /* __linux__ */
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+      /* The expiries are processed by the scheduler, which has to be woken up for each tick */
+      rtcos_posix_wakeup();
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+    }
+  }
+  return NULL;
+}
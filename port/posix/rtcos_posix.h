@@ -0,0 +1,41 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : rtcos_posix.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS POSIX port: tick thread, mutex critical sections and blocking idle
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_POSIX_H
+#define RTCOS_POSIX_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+/** Pass to rtcos_posix_set_realtime() to leave the threads on any CPU */
+#define RTCOS_POSIX_ANY_CPU                      (int16_t)-1
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Functions                                                                                     */
+/*-----------------------------------------------------------------------------------------------*/
+#if defined(__cplusplus)
+extern "C"
+{
+#endif /* __cplusplus */
+
+rtcos_status_t rtcos_posix_init(uint32_t);
+rtcos_status_t rtcos_posix_set_realtime(uint8_t, int16_t);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* RTCOS_POSIX_H */
@@ -15,11 +15,303 @@
 /*-----------------------------------------------------------------------------------------------*/
 #include "config.h"
 #include "rtcos.h"
+#if defined(RTCOS_ENABLE_LOCKFREE_MESSAGES) || defined(RTCOS_ENABLE_ISR_EVENTS) ||                \
+    defined(RTCOS_ENABLE_STATS) || defined(RTCOS_ENABLE_TRACE) || defined(RTCOS_ENABLE_TIME64)
+#include <stdatomic.h>
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES || RTCOS_ENABLE_ISR_EVENTS || RTCOS_ENABLE_STATS ||
+          RTCOS_ENABLE_TRACE || RTCOS_ENABLE_TIME64 */
+#ifdef RTCOS_ENABLE_WORKERS
+#include <pthread.h>
+#include <sched.h>
+#endif /* RTCOS_ENABLE_WORKERS */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private defines                                                                               */
+/*-----------------------------------------------------------------------------------------------*/
+/** Number of 32 bits words needed to hold one ready bit per task */
+#define RTCOS_READY_WORDS_COUNT                  ((RTCOS_MAX_TASKS_COUNT + 31) / 32)
+
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+#if (0 != (RTCOS_MAX_MESSAGES_COUNT & (RTCOS_MAX_MESSAGES_COUNT - 1))) ||                        \
+    (RTCOS_MAX_MESSAGES_COUNT > 128)
+#error "RTCOS lock-free message rings need a power of two RTCOS_MAX_MESSAGES_COUNT up to 128"
+#endif
+/** Mask giving the ring slot index out of a free running position */
+#define RTCOS_FIFO_INDEX_MASK                    (uint32_t)(RTCOS_MAX_MESSAGES_COUNT - 1)
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+
+#if defined(RTCOS_ENABLE_LOCKFREE_MESSAGES) || defined(RTCOS_ENABLE_ISR_EVENTS)
+/** Producers that cannot take the critical section flag ready tasks in an atomic bitmap */
+#define RTCOS_ENABLE_PENDING_READY_MAP
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES || RTCOS_ENABLE_ISR_EVENTS */
+
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+/** Pool blocks and message payloads are aligned on 8 bytes */
+#define RTCOS_MSG_ALIGN(u32Size)                 (((u32Size) + 7uL) & ~7uL)
+#define RTCOS_MSG_HEADER_SIZE                    RTCOS_MSG_ALIGN(sizeof(rtcos_msg_block_t))
+#define RTCOS_MSG_BLOCK_STRIDE(u16Size)          (RTCOS_MSG_HEADER_SIZE + RTCOS_MSG_ALIGN(u16Size))
+/** Expansions of RTCOS_MESSAGE_POOLS() giving the pools count, arena size and pools table */
+#define RTCOS_MSG_POOL_COUNT_ONE(u16Size, u16Count) + 1
+#define RTCOS_MSG_POOL_ADD_SIZE(u16Size, u16Count) + ((u16Count) * RTCOS_MSG_BLOCK_STRIDE(u16Size))
+#define RTCOS_MSG_POOL_CONFIG(u16Size, u16Count) { (u16Size), (u16Count) },
+#define RTCOS_MSG_POOLS_COUNT                    (0 RTCOS_MESSAGE_POOLS(RTCOS_MSG_POOL_COUNT_ONE))
+#define RTCOS_MSG_ARENA_SIZE                     (0 RTCOS_MESSAGE_POOLS(RTCOS_MSG_POOL_ADD_SIZE))
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+#if (0 != (RTCOS_MESSAGE_RING_SIZE % 4)) || (RTCOS_MESSAGE_RING_SIZE > 32768)
+#error "RTCOS_MESSAGE_RING_SIZE must be a multiple of 4 and at most 32768"
+#endif
+/** Each ring message starts with its length on a 4 bytes header and is padded to 4 bytes */
+#define RTCOS_RING_HEADER_SIZE                   (uint16_t)4
+#define RTCOS_RING_ALIGN(u32Size)                (((uint32_t)(u32Size) + 3uL) & ~(uint32_t)3)
+/** Largest message a ring can hold, it takes the whole ring with its header */
+#define RTCOS_RING_MAX_MESSAGE_SIZE              (RTCOS_MESSAGE_RING_SIZE - RTCOS_RING_HEADER_SIZE)
+/** Length found at the end of the ring when the next message starts back at offset 0 */
+#define RTCOS_RING_WRAP_MARK                     (uint16_t)0xFFFF
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+/** Task event flags are atomic so that they can be posted and cleared without masking interrupts,
+  * RTCOS_TASK_EVENTS_SET() then returns the flags that were pending before the post */
+#define RTCOS_TASK_EVENTS_GET(u08TaskID)                                                          \
+  atomic_load_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags, memory_order_relaxed)
+#define RTCOS_TASK_EVENTS_SET(u08TaskID, u32Flags)                                                \
+  atomic_fetch_or_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags, (u32Flags),        \
+                           memory_order_release)
+#define RTCOS_TASK_EVENTS_CLEAR(u08TaskID, u32Flags)                                              \
+  atomic_fetch_and_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags, ~(u32Flags),      \
+                            memory_order_relaxed)
+#define RTCOS_TASK_EVENTS_TAKE(u08TaskID)                                                         \
+  atomic_exchange_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags, 0,                 \
+                           memory_order_acquire)
+#else
+#define RTCOS_TASK_EVENTS_GET(u08TaskID)         RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags
+#define RTCOS_TASK_EVENTS_SET(u08TaskID, u32Flags)                                                \
+  (RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags |= (u32Flags))
+#define RTCOS_TASK_EVENTS_CLEAR(u08TaskID, u32Flags)                                              \
+  (RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags &= ~(u32Flags))
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+
+#ifdef RTCOS_ENABLE_WORKERS
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+#error "RTCOS workers process the ticks in rtcos_update_tick, drop RTCOS_ENABLE_DEFERRED_TICK"
+#endif
+#if (RTCOS_WORKERS_COUNT < 1) || (RTCOS_WORKERS_COUNT > 127)
+#error "RTCOS_WORKERS_COUNT must be between 1 and 127"
+#endif
+/** Scheduling state of a task, a task is queued at most once and run by one worker at a time */
+#define RTCOS_TASK_STATE_IDLE                    (uint8_t)0
+#define RTCOS_TASK_STATE_QUEUED                  (uint8_t)1
+#define RTCOS_TASK_STATE_RUNNING                 (uint8_t)2
+/** A deque never holds more than every task once, task IDs being 8 bits wide */
+#define RTCOS_DEQUE_SIZE                         256
+#define RTCOS_DEQUE_INDEX_MASK                   (uint32_t)(RTCOS_DEQUE_SIZE - 1)
+/** Priority band of a task, band 0 holds the highest priority tasks */
+#define RTCOS_TASK_BAND(u08TaskID)                                                                \
+  (uint8_t)(((uint32_t)RTCOS_TASK_PRIORITY(u08TaskID) * RTCOS_WORKER_PRIORITY_BANDS) /            \
+            RTCOS_TASK_LEVELS_COUNT)
+/** Number of empty scans a worker does before going to sleep */
+#define RTCOS_WORKER_SPIN_COUNT                  64
+/** The task handled by the calling thread is per worker */
+#define RTCOS_CURRENT_TASK_ID                    RTCOSi_u08WorkerTaskID
+#else
+#define RTCOS_CURRENT_TASK_ID                    RTCOSi_stMain.u08CurrentTaskID
+#endif /* RTCOS_ENABLE_WORKERS */
+
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+#if (0 == RTCOS_PRIORITY_LEVELS_COUNT) || (RTCOS_PRIORITY_LEVELS_COUNT > 32)
+#error "RTCOS_PRIORITY_LEVELS_COUNT must be between 1 and 32"
+#endif
+/** Priority level of a task, several tasks may share a level */
+#define RTCOS_TASK_PRIORITY(u08TaskID)           RTCOSi_stMain.tu08TaskPriority[u08TaskID]
+#define RTCOS_TASK_LEVELS_COUNT                  RTCOS_PRIORITY_LEVELS_COUNT
+#else
+/** Each task has a level of its own, its ID */
+#define RTCOS_TASK_PRIORITY(u08TaskID)           (u08TaskID)
+#define RTCOS_TASK_LEVELS_COUNT                  RTCOS_MAX_TASKS_COUNT
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+#ifdef RTCOS_ENABLE_WORKERS
+#error "RTCOS_ENABLE_FAIR_SCHEDULING needs the single thread scheduler, drop RTCOS_ENABLE_WORKERS"
+#endif
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+#ifdef RTCOS_ENABLE_WORKERS
+#error "RTCOS_ENABLE_EDF_SCHEDULING needs the single thread scheduler, drop RTCOS_ENABLE_WORKERS"
+#endif
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+#error "RTCOS_ENABLE_EDF_SCHEDULING and RTCOS_ENABLE_FAIR_SCHEDULING are exclusive"
+#endif
+/** Deadlines are tick counts that wrap, A is before B when the signed difference is negative */
+#define RTCOS_DEADLINE_BEFORE(u32A, u32B)        ((int32_t)((u32A) - (u32B)) < 0)
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+
+#ifdef RTCOS_ENABLE_STATS
+#ifndef RTCOS_PORT_TIMESTAMP
+#error "RTCOS_ENABLE_STATS needs the port to define RTCOS_PORT_TIMESTAMP()"
+#endif
+/** Busy and idle times are kept per scheduling loop, there is one per worker */
+#ifdef RTCOS_ENABLE_WORKERS
+#define RTCOS_STATS_LOOPS_COUNT                  RTCOS_WORKERS_COUNT
+#else
+#define RTCOS_STATS_LOOPS_COUNT                  1
+#endif /* RTCOS_ENABLE_WORKERS */
+#endif /* RTCOS_ENABLE_STATS */
+
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+#ifndef RTCOS_PORT_TIMESTAMP
+#error "RTCOS_ENABLE_TASK_BUDGETS needs the port to define RTCOS_PORT_TIMESTAMP()"
+#endif
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+
+#ifdef RTCOS_ENABLE_TRACE
+#ifndef RTCOS_PORT_TIMESTAMP
+#error "RTCOS_ENABLE_TRACE needs the port to define RTCOS_PORT_TIMESTAMP()"
+#endif
+#if (0 != (RTCOS_TRACE_RECORDS_COUNT & (RTCOS_TRACE_RECORDS_COUNT - 1)))
+#error "RTCOS_TRACE_RECORDS_COUNT must be a power of two"
+#endif
+/** Header of a trace dump, the magic reads "RTCT" in a little endian dump */
+#define RTCOS_TRACE_MAGIC                        0x54435452uL
+#define RTCOS_TRACE_VERSION                      (uint16_t)1
+/** Mask giving the record index out of a free running position */
+#define RTCOS_TRACE_INDEX_MASK                   (uint32_t)(RTCOS_TRACE_RECORDS_COUNT - 1)
+#define RTCOS_TRACE(u08Kind, u08TaskID, u32Value)                                                 \
+  _rtcos_trace_record((uint8_t)(u08Kind), (u08TaskID), (uint32_t)(u32Value))
+#else
+#define RTCOS_TRACE(u08Kind, u08TaskID, u32Value)
+#endif /* RTCOS_ENABLE_TRACE */
+
+#ifdef RTCOS_ENABLE_STATIC_TASKS
+#ifdef RTCOS_ENABLE_INSTANCES
+#error "RTCOS_ENABLE_STATIC_TASKS has a single task table, drop RTCOS_ENABLE_INSTANCES"
+#endif
+/** Handlers and arguments are read from the const table built with RTCOS_TASK_DEFINE() */
+#define RTCOS_TASK_HANDLER(u08TaskID)            RTCOS_tstStaticTasks[u08TaskID].pfTaskHandlerCb
+#define RTCOS_TASK_ARG(u08TaskID)                RTCOS_tstStaticTasks[u08TaskID].pvArg
+/** A slot of the table without a handler is skipped: it never gets events nor messages */
+#define RTCOS_TASK_EXISTS(u08TaskID)                                                              \
+  (((u08TaskID) < RTCOSi_stMain.u08TasksCount) && (NULL != RTCOS_TASK_HANDLER(u08TaskID)))
+#else
+#define RTCOS_TASK_HANDLER(u08TaskID)            RTCOSi_stMain.tstTasks[u08TaskID].pfTaskHandlerCb
+#define RTCOS_TASK_ARG(u08TaskID)                RTCOSi_stMain.tstTasks[u08TaskID].pvArg
+#define RTCOS_TASK_EXISTS(u08TaskID)             ((u08TaskID) < RTCOSi_stMain.u08TasksCount)
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+/** Posts of a counted event are counted up to this value */
+#define RTCOS_EVENT_COUNT_MAX                    (uint8_t)255
+/** Number of event flags of a task */
+#define RTCOS_EVENTS_COUNT                       32
+/** Counts a post before its flags are set, so that the dispatch taking the flags sees the count */
+#define RTCOS_EVENT_COUNTS_POST(u08TaskID, u32Flags)                                              \
+  _rtcos_event_counts_post((u08TaskID), (u32Flags))
+#else
+#define RTCOS_EVENT_COUNTS_POST(u08TaskID, u32Flags)
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+
+#if (RTCOS_MAX_FUTURE_EVENTS_COUNT > 0xFFFE)
+#error "RTCOS_MAX_FUTURE_EVENTS_COUNT must not exceed 65534"
+#endif
+/** End of the per task and free lists of future events */
+#define RTCOS_FUTURE_EVENT_NONE                  (uint16_t)0xFFFF
+
+#ifdef RTCOS_ENABLE_TIMERS
+#if (RTCOS_MAX_TIMERS_COUNT > 255)
+#error "RTCOS_MAX_TIMERS_COUNT must not exceed 255"
+#endif
+#ifdef RTCOS_ENABLE_TIMER_HANDLES
+/** A timer handle holds the generation of its slot above the slot index, the generation goes
+  * from 1 to 127 so that handles are positive and an 8 bits ID is never a valid handle */
+#define RTCOS_TIMER_HANDLE(u08Index)                                                              \
+  (rtcos_timer_id_t)(((uint16_t)RTCOSi_stMain.tstTimers[u08Index].u08Generation << 8) | (u08Index))
+#define RTCOS_TIMER_INDEX(sTimerID)              (uint8_t)((uint16_t)(sTimerID) & 0xFF)
+#define RTCOS_TIMER_GENERATION(sTimerID)         (uint8_t)((uint16_t)(sTimerID) >> 8)
+#define RTCOS_TIMER_GENERATION_MAX               127
+/** The slot of a deleted handle may be held by a newer timer */
+#define RTCOS_TIMER_STALE(sTimerID, u08Index)                                                     \
+  (RTCOS_TIMER_GENERATION(sTimerID) != RTCOSi_stMain.tstTimers[u08Index].u08Generation)
+#else
+#if (RTCOS_MAX_TIMERS_COUNT > 128)
+#error "RTCOS_MAX_TIMERS_COUNT must not exceed 128 without RTCOS_ENABLE_TIMER_HANDLES"
+#endif
+/** A timer ID is the index of its slot */
+#define RTCOS_TIMER_HANDLE(u08Index)             (rtcos_timer_id_t)(u08Index)
+#define RTCOS_TIMER_INDEX(sTimerID)              (uint8_t)(sTimerID)
+#define RTCOS_TIMER_STALE(sTimerID, u08Index)    false
+#endif /* RTCOS_ENABLE_TIMER_HANDLES */
+/** End of the timer free and active lists */
+#define RTCOS_TIMER_NONE                         (uint8_t)0xFF
+#endif /* RTCOS_ENABLE_TIMERS */
+
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+/** Tick count seen by the expiry processing, it lags the system tick count until serviced */
+#define RTCOS_EXPIRY_TICKS_COUNT                 RTCOSi_stMain.u32ProcessedTicksCount
+#define RTCOS_EXPIRY_TICKS_ADD(u32Ticks)         (RTCOS_EXPIRY_TICKS_COUNT += (u32Ticks))
+/** Ticks counted but not processed yet, a delay given now only starts once they are processed */
+#define RTCOS_PENDING_TICKS                                                                       \
+  (RTCOSi_stMain.u32SysTicksCount - RTCOSi_stMain.u32ProcessedTicksCount)
+/** The first period of a timer also covers the ticks that were pending when it was started */
+#define RTCOS_TIMER_DELAY(pstTimer)                                                               \
+  ((pstTimer)->u32TickDelay + (pstTimer)->u32StartDelay)
+#define RTCOS_TIMER_CLEAR_START_DELAY(pstTimer)  ((pstTimer)->u32StartDelay = 0)
+/** Timer callbacks are called from the scheduler with interrupts unmasked */
+#define RTCOS_TIMER_CB_PROLOGUE()                RTCOS_EXIT_CRITICAL_SECTION()
+#define RTCOS_TIMER_CB_EPILOGUE()                RTCOS_ENTER_CRITICAL_SECTION()
+#else
+#define RTCOS_EXPIRY_TICKS_COUNT                 RTCOSi_stMain.u32SysTicksCount
+#define RTCOS_EXPIRY_TICKS_ADD(u32Ticks)         _rtcos_add_ticks(u32Ticks)
+#define RTCOS_PENDING_TICKS                      (uint32_t)0
+#define RTCOS_TIMER_DELAY(pstTimer)              ((pstTimer)->u32TickDelay)
+#define RTCOS_TIMER_CLEAR_START_DELAY(pstTimer)
+#define RTCOS_TIMER_CB_PROLOGUE()
+#define RTCOS_TIMER_CB_EPILOGUE()
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+#if ((RTCOS_TIMING_WHEEL_SLOT_BITS * RTCOS_TIMING_WHEEL_LEVELS) > 31)
+#error "RTCOS timing wheel must cover less than 2^32 ticks"
+#endif
+/** Number of slots in each level of the timing wheel */
+#define RTCOS_WHEEL_SLOTS_COUNT                  (1uL << RTCOS_TIMING_WHEEL_SLOT_BITS)
+/** Mask giving the slot index out of a tick count */
+#define RTCOS_WHEEL_SLOT_MASK                    (RTCOS_WHEEL_SLOTS_COUNT - 1)
+/** Number of ticks covered by the whole wheel, longer delays go around the last level again */
+#define RTCOS_WHEEL_RANGE                        (1uL << (RTCOS_TIMING_WHEEL_SLOT_BITS *          \
+                                                          RTCOS_TIMING_WHEEL_LEVELS))
+/** Kind of the object a wheel node is embedded in */
+#define RTCOS_WHEEL_NODE_EVENT                   (uint8_t)0
+#define RTCOS_WHEEL_NODE_TIMER                   (uint8_t)1
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
 
 /*-----------------------------------------------------------------------------------------------*/
 /* Private types                                                                                 */
 /*-----------------------------------------------------------------------------------------------*/
-#ifdef RTCOS_ENABLE_MESSAGES
+#if defined(RTCOS_ENABLE_LOCKFREE_MESSAGES) && !defined(RTCOS_LOCKFREE_SINGLE_PRODUCER)
+/** Slot of a multi producer ring, the sequence tells whose turn it is to use the slot */
+typedef struct
+{
+  _Atomic uint32_t u32Sequence;                  /**< Position + 1 once the message is published */
+  void *pvMsg;                                   /**< Message pointer                            */
+}rtcos_fifo_slot_t;
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+
+#if defined(RTCOS_ENABLE_LOCKFREE_MESSAGES)
+/** Lock-free ring used for storing messages, the positions are free running counters */
+typedef struct
+{
+  _Atomic uint32_t u32Head;                      /**< Next position given to a producer          */
+  _Atomic uint32_t u32Tail;                      /**< Next position read by the consumer task    */
+#ifdef RTCOS_LOCKFREE_SINGLE_PRODUCER
+  void *tpvBuffer[RTCOS_MAX_MESSAGES_COUNT];     /**< Ring buffer of pointers                    */
+#else
+  rtcos_fifo_slot_t tstSlots[RTCOS_MAX_MESSAGES_COUNT]; /**< Ring buffer of sequenced pointers   */
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+}rtcos_fifo_t;
+#elif defined(RTCOS_ENABLE_MESSAGES)
 /** Fifo structure used for storing messages */
 typedef struct
 {
@@ -30,12 +322,69 @@ typedef struct
 }rtcos_fifo_t;
 #endif /* RTCOS_ENABLE_MESSAGES */
 
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+/** Ring of variable-length messages stored inline, its positions are protected by the critical
+  * section while the payloads are written and read in place */
+typedef struct
+{
+  uint16_t u16Head;                              /**< Offset of the next message to write        */
+  uint16_t u16Tail;                              /**< Offset of the oldest message               */
+#ifdef RTCOS_ENABLE_WORKERS
+  _Atomic uint16_t u16Used;                      /**< Committed bytes, padding included          */
+#else
+  volatile uint16_t u16Used;                     /**< Committed bytes, padding included          */
+#endif /* RTCOS_ENABLE_WORKERS */
+  uint16_t u16Reserved;                          /**< Size asked by the pending reservation      */
+  uint16_t u16ReservedOffset;                    /**< Offset of the pending reservation          */
+  uint32_t tu32Data[RTCOS_MESSAGE_RING_SIZE / 4]; /**< Messages, aligned on 4 bytes              */
+}rtcos_ring_t;
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+/** Header of a pool block, the message payload follows it */
+typedef struct rtcos_msg_block
+{
+  struct rtcos_msg_block *pstNext;               /**< Next free block of the same pool           */
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+  _Atomic uint16_t u16RefCount;                  /**< Owners of the message, 0 while free        */
+#else
+  uint16_t u16RefCount;                          /**< Owners of the message, 0 while free        */
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+  uint8_t u08Pool;                               /**< Index of the pool owning the block         */
+}rtcos_msg_block_t;
+
+/** Size class of a message pool */
+typedef struct
+{
+  uint16_t u16BlockSize;                         /**< Largest message a block can hold           */
+  uint16_t u16BlocksCount;                       /**< Number of blocks in the pool               */
+}rtcos_msg_pool_config_t;
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+/** Timing wheel node, first member of every object that can be scheduled on the wheel */
+typedef struct rtcos_wheel_node
+{
+  struct rtcos_wheel_node *pstNext;             /**< Next node in the same slot                 */
+  struct rtcos_wheel_node **ppstPrev;           /**< Link pointing at this node, NULL if unused */
+  uint32_t u32ExpiryTick;                       /**< Wheel tick at which the node expires       */
+  uint8_t u08Kind;                              /**< RTCOS_WHEEL_NODE_EVENT or _TIMER           */
+  uint8_t u08Level;                             /**< Wheel level the node is linked in          */
+}rtcos_wheel_node_t;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+
 /** Future event structure representing information about each event */
 typedef struct
 {
-  uint32_t u32EventFlags;                       /**< 32 bits representing different events      */
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+  rtcos_wheel_node_t stNode;                    /**< Position of the event in the timing wheel  */
+#else
   volatile uint32_t u32EventDelay;              /**< Delay to wait before handling the event    */
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+  uint32_t u32EventFlags;                       /**< 32 bits representing different events      */
   uint32_t u32ReloadDelay;                      /**< Delay to wait before reloading the event   */
+  uint16_t u16Next;                             /**< Next event of the task or of the free list */
+  uint16_t u16Prev;                             /**< Previous event of the same task            */
   uint8_t u08TaskID;                            /**< ID of the task associated with this event  */
   volatile bool bInUse;                         /**< Indicates if the event is still used       */
 }rtcos_future_event_t;
@@ -44,51 +393,448 @@ typedef struct
 /** Software os timer structure representing information about each timer */
 typedef struct
 {
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+  rtcos_wheel_node_t stNode;                     /**< Position of the timer in the timing wheel  */
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
   volatile bool bInUse;                          /**< Indicates if the timer is still used       */
+  bool bCreated;                                 /**< The slot is held by a created timer        */
+#ifdef RTCOS_ENABLE_TIMER_HANDLES
+  uint8_t u08Generation;                         /**< Bumped each time the timer is deleted      */
+#endif /* RTCOS_ENABLE_TIMER_HANDLES */
+  uint8_t u08Next;                               /**< Next timer in the free or active list      */
+#ifndef RTCOS_ENABLE_TIMING_WHEEL
+  uint8_t u08Prev;                               /**< Previous timer in the active list          */
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
   rtcos_timer_type_t ePeriodType;                /**< Periodic or one shot timer                 */
   volatile uint32_t	u32StartTickCount;           /**< Start time of the timer                    */
   uint32_t u32TickDelay;                         /**< Period of the timer                        */
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+  uint32_t u32StartDelay;                        /**< Ticks pending when the timer was started   */
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
   pf_os_timer_cb_t pfTimerCb;                    /**< Timer callback function                    */
   void *pvArg;                                   /**< Timer callback argument                    */
 }rtcos_timer_t;
 #endif /* RTCOS_ENABLE_TIMERS */
 
+#ifdef RTCOS_ENABLE_WORKERS
+/** Chase-Lev work stealing deque of task IDs: the owner pushes and pops at the bottom,
+  * other workers steal from the top */
+typedef struct
+{
+  _Atomic uint32_t u32Top;                       /**< Next position stolen by another worker     */
+  _Atomic uint32_t u32Bottom;                    /**< Next position pushed by the owner          */
+  _Atomic uint8_t tu08Buffer[RTCOS_DEQUE_SIZE];  /**< Ring buffer of task IDs                    */
+}rtcos_deque_t;
+
+/** Worker structure holding the deques of one thread */
+typedef struct
+{
+  rtcos_deque_t tstDeques[RTCOS_WORKER_PRIORITY_BANDS]; /**< One deque per priority band         */
+  pthread_t stThread;                            /**< Thread running this worker                 */
+#ifdef RTCOS_ENABLE_INSTANCES
+  struct rtcos_main *pstMain;                    /**< Scheduler instance of this worker          */
+#endif /* RTCOS_ENABLE_INSTANCES */
+}rtcos_worker_t;
+#endif /* RTCOS_ENABLE_WORKERS */
+
+#ifdef RTCOS_ENABLE_STATS
+/** Busy and idle time of a scheduling loop, published the same way as the task statistics */
+typedef struct
+{
+  _Atomic uint32_t u32Sequence;                  /**< Odd while the times are being updated      */
+  uint64_t u64BusyTime;                          /**< Time spent on passes that did some work    */
+  uint64_t u64IdleTime;                          /**< Time spent on passes that found nothing    */
+}rtcos_loop_time_t;
+#endif /* RTCOS_ENABLE_STATS */
+
+#ifdef RTCOS_ENABLE_TRACE
+/** Trace ring buffer, dumped as is and decoded on the host by tools/trace */
+typedef struct
+{
+  uint32_t u32Magic;                             /**< RTCOS_TRACE_MAGIC                          */
+  uint16_t u16Version;                           /**< RTCOS_TRACE_VERSION                        */
+  uint16_t u16RecordSize;                        /**< Size of one record in bytes                */
+  uint32_t u32RecordsCount;                      /**< Number of records in the ring              */
+  _Atomic uint32_t u32Head;                      /**< Records written since start-up             */
+  rtcos_trace_record_t tstRecords[RTCOS_TRACE_RECORDS_COUNT]; /**< Ring of records               */
+}rtcos_trace_t;
+#endif /* RTCOS_ENABLE_TRACE */
+
 /** Task structure representing information about each task */
 typedef struct
 {
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+  _Atomic uint32_t u32EventFlags;                /**< Event flags associated to this task        */
+#else
   volatile uint32_t u32EventFlags;               /**< Event flags associated to this task        */
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+#ifndef RTCOS_ENABLE_STATIC_TASKS
   pf_os_task_handler_t pfTaskHandlerCb;          /**< Task handler function                      */
    void *pvArg;                                  /**< Task argument                              */
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+  uint16_t u16FutureEvents;                      /**< First pending future event of this task    */
 #ifdef RTCOS_ENABLE_MESSAGES
   rtcos_fifo_t stFifo;                           /**< Fifo associated to this task               */
 #endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+  rtcos_ring_t stRing;                           /**< Inline message ring of this task           */
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+#ifdef RTCOS_ENABLE_WORKERS
+  _Atomic uint8_t u08State;                      /**< Idle, queued or running on a worker        */
+#endif /* RTCOS_ENABLE_WORKERS */
+#ifdef RTCOS_ENABLE_STATS
+  _Atomic uint32_t u32StatsSequence;             /**< Odd while the statistics are being updated */
+  rtcos_task_stats_t stStats;                    /**< Statistics published after each handler    */
+  uint32_t u32MessagesTaken;                     /**< Messages taken by the running handler      */
+#endif /* RTCOS_ENABLE_STATS */
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+  uint32_t u32CountedEvents;                     /**< Events whose posts are counted             */
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+  _Atomic uint8_t tu08EventCounts[RTCOS_EVENTS_COUNT]; /**< Pending posts of each counted event  */
+#else
+  uint8_t tu08EventCounts[RTCOS_EVENTS_COUNT];   /**< Pending posts of each counted event        */
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+  uint32_t u32RunEvents;                         /**< Events given to the running handler call   */
+  uint8_t tu08RunCounts[RTCOS_EVENTS_COUNT];     /**< Posts given to the running handler call    */
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+  rtcos_task_overruns_t stOverruns;              /**< Budget and overruns of the handler calls   */
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+  uint32_t u32ReadySince;                        /**< Tick of the last wakeup or dispatch        */
+  uint32_t u32MaxWaitTicks;                      /**< Longest time spent ready before a dispatch */
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+  uint32_t u32RelativeDeadline;                  /**< Deadline given to new work, 0 for none     */
+  uint32_t u32Deadline;                          /**< Deadline of the pending work               */
+  uint32_t u32RunDeadline;                       /**< Deadline of the running handler call       */
+  bool bRunHasDeadline;                          /**< The running handler call has a deadline    */
+  uint32_t u32DeadlineMisses;                    /**< Handler calls that ended past the deadline */
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
 }rtcos_task_t;
 
-/** Context structure representing the main context of the OS */
+/** Two-level bitmap of ready tasks, the MSB of each word stands for the lowest task ID */
 typedef struct
+{
+#if (RTCOS_READY_WORDS_COUNT > 1)
+  uint32_t u32GroupMap;                          /**< Bit set for each non empty ready word      */
+#endif /* RTCOS_READY_WORDS_COUNT */
+  uint32_t tu32Map[RTCOS_READY_WORDS_COUNT];     /**< Bit set for each ready task                */
+}rtcos_ready_map_t;
+
+/** Context structure representing the main context of the OS */
+typedef struct rtcos_main
 {
   uint8_t u08TasksCount;                         /**< Number of the tasks present in the system  */
   uint8_t u08CurrentTaskID;                      /**< Current task ID                            */
+  rtcos_ready_map_t stReadyMap;                  /**< Tasks having event(s) or message(s)        */
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+#ifdef RTCOS_ENABLE_WORKERS
+  _Atomic uint8_t tu08TaskPriority[RTCOS_MAX_TASKS_COUNT]; /**< Priority level of each task      */
+#else
+  uint8_t tu08TaskPriority[RTCOS_MAX_TASKS_COUNT]; /**< Priority level of each task              */
+#endif /* RTCOS_ENABLE_WORKERS */
+#ifndef RTCOS_ENABLE_WORKERS
+  uint32_t u32LevelMap;                          /**< Bit set for each level having a ready task */
+  uint32_t tu32LevelTasks[RTCOS_PRIORITY_LEVELS_COUNT][RTCOS_READY_WORDS_COUNT]; /**< Ready tasks */
+#endif /* RTCOS_ENABLE_WORKERS */
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+  uint32_t tu32AgedMap[RTCOS_READY_WORDS_COUNT]; /**< Boosted tasks, indexed by task ID          */
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+  uint8_t tu08LastTask[RTCOS_PRIORITY_LEVELS_COUNT]; /**< Last task dispatched at each level     */
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+  uint32_t u32AgingTick;                         /**< Tick of the last aging scan                */
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+  uint32_t tu32DeadlineMap[RTCOS_READY_WORDS_COUNT]; /**< Pending deadlines, indexed by task ID  */
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+#ifdef RTCOS_ENABLE_PENDING_READY_MAP
+  _Atomic uint32_t tu32PendingMap[RTCOS_READY_WORDS_COUNT]; /**< Tasks made ready lock-free   */
+#endif /* RTCOS_ENABLE_PENDING_READY_MAP */
   volatile uint32_t u32SysTicksCount;            /**< Current number of the system ticks         */
+#ifdef RTCOS_ENABLE_TIME64
+  volatile uint32_t u32SysTicksHigh;             /**< Wraps of the system tick count             */
+  _Atomic uint32_t u32TimeSequence;              /**< Odd while the tick count is being updated  */
+#endif /* RTCOS_ENABLE_TIME64 */
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+  volatile uint32_t u32ProcessedTicksCount;      /**< Ticks already handled by the timer service */
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
   pf_os_idle_handler_t pfIdleHandler;            /**< Handler function when the system is Idle   */
-  volatile uint8_t u08FutureEventsCount;         /**< Number of the events present in the system */
+  volatile uint16_t u16FutureEventsCount;        /**< Number of the events present in the system */
+  uint16_t u16FreeFutureEvents;                  /**< First slot of the future event free list   */
   rtcos_future_event_t tstFutureEvents[RTCOS_MAX_FUTURE_EVENTS_COUNT]; /**< Array of events      */
   rtcos_task_t tstTasks[RTCOS_MAX_TASKS_COUNT];  /**< Array of tasks                             */
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+  rtcos_msg_block_t *tpstMsgFreeLists[RTCOS_MSG_POOLS_COUNT]; /**< Free blocks of each pool      */
+  uint64_t tu64MsgArena[RTCOS_MSG_ARENA_SIZE / 8]; /**< Storage of all the pool blocks           */
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
 #ifdef RTCOS_ENABLE_TIMERS
   rtcos_timer_t tstTimers[RTCOS_MAX_TIMERS_COUNT]; /**< Array of timers                          */
   uint8_t u08TimersCount;                        /**< Number of the timers present in the system */
+  uint8_t u08FreeTimers;                         /**< First slot of the timer free list          */
+#ifndef RTCOS_ENABLE_TIMING_WHEEL
+  uint8_t u08ActiveTimers;                       /**< First running timer, scanned on each tick  */
+  uint8_t u08TimerScanNext;                      /**< Next timer of the scan in progress         */
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
 #endif /* RTCOS_ENABLE_TIMERS */
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+  uint32_t u32WheelTick;                         /**< Last tick processed by the timing wheel    */
+  rtcos_wheel_node_t *tpstWheel[RTCOS_TIMING_WHEEL_LEVELS][RTCOS_WHEEL_SLOTS_COUNT]; /**< Slots  */
+  uint16_t tu16WheelLevelCount[RTCOS_TIMING_WHEEL_LEVELS]; /**< Number of nodes in each level    */
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+#ifdef RTCOS_ENABLE_WORKERS
+  rtcos_worker_t tstWorkers[RTCOS_WORKERS_COUNT]; /**< Array of workers                          */
+  _Atomic int32_t s32QueuedCount;                /**< Tasks queued and not yet taken by a worker */
+  _Atomic int32_t s32SleepersCount;              /**< Workers waiting for a task to be queued    */
+  pthread_mutex_t stSleepMutex;                  /**< Protects the workers sleep                 */
+  pthread_cond_t stSleepCond;                    /**< Signaled when a task is queued             */
+#endif /* RTCOS_ENABLE_WORKERS */
+#ifdef RTCOS_ENABLE_STATS
+  rtcos_loop_time_t tstLoopTimes[RTCOS_STATS_LOOPS_COUNT]; /**< Busy and idle time of each loop  */
+#endif /* RTCOS_ENABLE_STATS */
+#ifdef RTCOS_ENABLE_TRACE
+  _Atomic bool bTraceEnabled;                    /**< Records are dropped while false            */
+#endif /* RTCOS_ENABLE_TRACE */
 }rtcos_main_t;
 
 /*-----------------------------------------------------------------------------------------------*/
 /* Private variables                                                                             */
 /*-----------------------------------------------------------------------------------------------*/
+#ifdef RTCOS_ENABLE_INSTANCES
+/** Scheduler instances, the first one is the default instance */
+static rtcos_main_t RTCOSi_tstInstances[RTCOS_MAX_INSTANCES_COUNT];
+/** Instances handed out by rtcos_create() and not destroyed yet, the default one is always used */
+static bool RTCOSi_tbInstancesUsed[RTCOS_MAX_INSTANCES_COUNT] = { true };
+/** Instance the calling thread operates on, every other function reaches it through
+  * RTCOSi_stMain */
+static _Thread_local rtcos_main_t *RTCOSi_pstMain = &RTCOSi_tstInstances[0];
+#define RTCOSi_stMain                            (*RTCOSi_pstMain)
+#else
 static rtcos_main_t RTCOSi_stMain;
+#endif /* RTCOS_ENABLE_INSTANCES */
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+static const rtcos_msg_pool_config_t RTCOSi_tstMsgPools[RTCOS_MSG_POOLS_COUNT] =
+{
+  RTCOS_MESSAGE_POOLS(RTCOS_MSG_POOL_CONFIG)
+};
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+#ifdef RTCOS_ENABLE_TRACE
+/** Shared by every instance, the header is constant and the head only moves forward so that
+  * rtcos_init() never has to touch it */
+static rtcos_trace_t RTCOSi_stTrace =
+{
+  RTCOS_TRACE_MAGIC,
+  RTCOS_TRACE_VERSION,
+  (uint16_t)sizeof(rtcos_trace_record_t),
+  RTCOS_TRACE_RECORDS_COUNT,
+  0,
+  { { 0 } }
+};
+#endif /* RTCOS_ENABLE_TRACE */
+#ifdef RTCOS_ENABLE_WORKERS
+/** Index of the worker running on the calling thread, -1 outside the workers */
+static _Thread_local int8_t RTCOSi_s08WorkerID = -1;
+/** Task whose handler runs on the calling thread */
+static _Thread_local uint8_t RTCOSi_u08WorkerTaskID;
+#endif /* RTCOS_ENABLE_WORKERS */
 
 /*-----------------------------------------------------------------------------------------------*/
 /* Private functions                                                                             */
 /*-----------------------------------------------------------------------------------------------*/
-#ifdef RTCOS_ENABLE_MESSAGES
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+/** ***********************************************************************************************
+  * @brief      Initialize the lock-free ring that will hold a task's messages
+  * @param      u08TaskID ID of the task using this fifo
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_fifo_init(uint8_t u08TaskID)
+{
+  rtcos_fifo_t *pstFifo;
+#ifndef RTCOS_LOCKFREE_SINGLE_PRODUCER
+  uint32_t u32Index;
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+
+  pstFifo = &RTCOSi_stMain.tstTasks[u08TaskID].stFifo;
+  atomic_init(&pstFifo->u32Head, 0);
+  atomic_init(&pstFifo->u32Tail, 0);
+#ifndef RTCOS_LOCKFREE_SINGLE_PRODUCER
+  for(u32Index = 0; u32Index < RTCOS_MAX_MESSAGES_COUNT; ++u32Index)
+  {
+    atomic_init(&pstFifo->tstSlots[u32Index].u32Sequence, u32Index);
+    pstFifo->tstSlots[u32Index].pvMsg = NULL;
+  }
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+}
+
+/** ***********************************************************************************************
+  * @brief      Check if the ring of a certain task holds no published message,
+  *             only the consumer task gets a stable answer
+  * @param      u08TaskID ID of the task using this fifo
+  * @return     true if empty, else false
+  ********************************************************************************************** */
+static bool _rtcos_fifo_empty(uint8_t u08TaskID)
+{
+  rtcos_fifo_t *pstFifo;
+  uint32_t u32Tail;
+
+  pstFifo = &RTCOSi_stMain.tstTasks[u08TaskID].stFifo;
+  u32Tail = atomic_load_explicit(&pstFifo->u32Tail, memory_order_relaxed);
+#ifdef RTCOS_LOCKFREE_SINGLE_PRODUCER
+  return (u32Tail == atomic_load_explicit(&pstFifo->u32Head, memory_order_acquire));
+#else
+  return ((u32Tail + 1) != atomic_load_explicit(
+            &pstFifo->tstSlots[u32Tail & RTCOS_FIFO_INDEX_MASK].u32Sequence, memory_order_acquire));
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the number of items in the ring, messages still being written by a producer
+  *             are counted too
+  * @param      u08TaskID ID of the task using this fifo
+  * @return     Number of items in the fifo
+  ********************************************************************************************** */
+static uint8_t _rtcos_fifo_count(uint8_t u08TaskID)
+{
+  rtcos_fifo_t *pstFifo;
+  uint32_t u32Count;
+
+  pstFifo = &RTCOSi_stMain.tstTasks[u08TaskID].stFifo;
+  u32Count = atomic_load_explicit(&pstFifo->u32Head, memory_order_relaxed) -
+             atomic_load_explicit(&pstFifo->u32Tail, memory_order_relaxed);
+  return (uint8_t)((u32Count > RTCOS_MAX_MESSAGES_COUNT)?RTCOS_MAX_MESSAGES_COUNT:u32Count);
+}
+
+/** ***********************************************************************************************
+  * @brief      Put a message on the ring of a certain task without masking interrupts.
+  *             With RTCOS_LOCKFREE_SINGLE_PRODUCER only one context may send to a given task,
+  *             otherwise producers claim a slot with a compare and swap on the head.
+  * @param      u08TaskID ID of the task using this fifo
+  * @param      pvMsg Pointer to the message
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_fifo_push(uint8_t u08TaskID, void *pvMsg)
+{
+  rtcos_status_t eRetVal;
+  rtcos_fifo_t *pstFifo;
+  uint32_t u32Head;
+#ifndef RTCOS_LOCKFREE_SINGLE_PRODUCER
+  rtcos_fifo_slot_t *pstSlot;
+  int32_t s32Diff;
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+
+  pstFifo = &RTCOSi_stMain.tstTasks[u08TaskID].stFifo;
+  u32Head = atomic_load_explicit(&pstFifo->u32Head, memory_order_relaxed);
+#ifdef RTCOS_LOCKFREE_SINGLE_PRODUCER
+  if((u32Head - atomic_load_explicit(&pstFifo->u32Tail, memory_order_acquire)) <
+     RTCOS_MAX_MESSAGES_COUNT)
+  {
+    pstFifo->tpvBuffer[u32Head & RTCOS_FIFO_INDEX_MASK] = pvMsg;
+    atomic_store_explicit(&pstFifo->u32Head, u32Head + 1, memory_order_release);
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_MSG_FULL;
+  }
+#else
+  eRetVal = RTCOS_ERR_ARG;
+  while(RTCOS_ERR_ARG == eRetVal)
+  {
+    pstSlot = &pstFifo->tstSlots[u32Head & RTCOS_FIFO_INDEX_MASK];
+    s32Diff = (int32_t)(atomic_load_explicit(&pstSlot->u32Sequence, memory_order_acquire) -
+                        u32Head);
+    if(0 == s32Diff)
+    {
+      /* The slot is free for this position, try to claim it */
+      if(atomic_compare_exchange_weak_explicit(&pstFifo->u32Head, &u32Head, u32Head + 1,
+                                               memory_order_relaxed, memory_order_relaxed))
+      {
+        pstSlot->pvMsg = pvMsg;
+        atomic_store_explicit(&pstSlot->u32Sequence, u32Head + 1, memory_order_release);
+        eRetVal = RTCOS_ERR_NONE;
+      }
+    }
+    else if(s32Diff < 0)
+    {
+      /* The slot still holds the message written one lap ago */
+      eRetVal = RTCOS_ERR_MSG_FULL;
+    }
+    else
+    {
+      /* Another producer claimed this position first */
+      u32Head = atomic_load_explicit(&pstFifo->u32Head, memory_order_relaxed);
+    }
+  }
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Retrieve a message of a certain task, only the task itself may call this
+  * @param      u08TaskID ID of the task using this fifo
+  * @param      ppvMsg Pointer to a pointer to the message
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_fifo_pop(uint8_t u08TaskID, void **ppvMsg)
+{
+  rtcos_status_t eRetVal;
+  rtcos_fifo_t *pstFifo;
+  uint32_t u32Tail;
+
+  if(false == _rtcos_fifo_empty(u08TaskID))
+  {
+    pstFifo = &RTCOSi_stMain.tstTasks[u08TaskID].stFifo;
+    u32Tail = atomic_load_explicit(&pstFifo->u32Tail, memory_order_relaxed);
+#ifdef RTCOS_LOCKFREE_SINGLE_PRODUCER
+    *ppvMsg = pstFifo->tpvBuffer[u32Tail & RTCOS_FIFO_INDEX_MASK];
+#else
+    *ppvMsg = pstFifo->tstSlots[u32Tail & RTCOS_FIFO_INDEX_MASK].pvMsg;
+    /* Hand the slot over to the producer that will write it on the next lap */
+    atomic_store_explicit(&pstFifo->tstSlots[u32Tail & RTCOS_FIFO_INDEX_MASK].u32Sequence,
+                          u32Tail + RTCOS_MAX_MESSAGES_COUNT, memory_order_release);
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+    atomic_store_explicit(&pstFifo->u32Tail, u32Tail + 1, memory_order_release);
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_MSG_EMPTY;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the oldest message of a certain task without removing it,
+  *             only the task itself may call this
+  * @param      u08TaskID ID of the task using this fifo
+  * @param      ppvMsg Pointer to a pointer to the message
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_fifo_peek(uint8_t u08TaskID, void **ppvMsg)
+{
+  rtcos_status_t eRetVal;
+  rtcos_fifo_t *pstFifo;
+  uint32_t u32Tail;
+
+  if(false == _rtcos_fifo_empty(u08TaskID))
+  {
+    pstFifo = &RTCOSi_stMain.tstTasks[u08TaskID].stFifo;
+    u32Tail = atomic_load_explicit(&pstFifo->u32Tail, memory_order_relaxed);
+#ifdef RTCOS_LOCKFREE_SINGLE_PRODUCER
+    *ppvMsg = pstFifo->tpvBuffer[u32Tail & RTCOS_FIFO_INDEX_MASK];
+#else
+    *ppvMsg = pstFifo->tstSlots[u32Tail & RTCOS_FIFO_INDEX_MASK].pvMsg;
+#endif /* RTCOS_LOCKFREE_SINGLE_PRODUCER */
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_MSG_EMPTY;
+  }
+  return eRetVal;
+}
+#elif defined(RTCOS_ENABLE_MESSAGES)
 /** ***********************************************************************************************
   * @brief      Initialize the fifo that will hold a task's messages
   * @param      u08TaskID ID of the task using this fifo
@@ -190,475 +936,3487 @@ static rtcos_status_t _rtcos_fifo_pop(uint8_t u08TaskID, void **ppvMsg)
   }
   return eRetVal;
 }
-#endif /* RTCOS_ENABLE_MESSAGES */
 
 /** ***********************************************************************************************
-  * @brief      Find the highest priority task with an event or a message
-  * @param      pu08ReadyTaskID This will hold the ID of the found ready task
-  * @return     true if a task is found, else false
+  * @brief      Read the oldest message of a certain task without removing it
+  * @param      u08TaskID ID of the task using this fifo
+  * @param      ppvMsg Pointer to a pointer to the message
+  * @return     Status as defined in ::rtcos_status_t
   ********************************************************************************************** */
-static bool _rtcos_find_ready_task(uint8_t *pu08ReadyTaskID)
+static rtcos_status_t _rtcos_fifo_peek(uint8_t u08TaskID, void **ppvMsg)
 {
-  uint8_t u08Index;
-  bool bRetVal;
+  rtcos_status_t eRetVal;
 
-  bRetVal = false;
-  if(pu08ReadyTaskID)
+  if(false == _rtcos_fifo_empty(u08TaskID))
   {
-    /* Loop over the tasks array */
-    for(u08Index = 0; u08Index < RTCOSi_stMain.u08TasksCount; ++u08Index)
-    {
-      /* If a task has event(s) or message(s) break and return its ID */
-      if((0 != RTCOSi_stMain.tstTasks[u08Index].u32EventFlags)
-#ifdef RTCOS_ENABLE_MESSAGES
-        || (false == _rtcos_fifo_empty(u08Index))
-#endif /* RTCOS_ENABLE_MESSAGES */
-        )
-      {
-        *pu08ReadyTaskID = u08Index;
-        bRetVal = true;
-        break;
-      }
-    }
+    *ppvMsg = RTCOSi_stMain
+                .tstTasks[u08TaskID]
+                  .stFifo.tpvBuffer[RTCOSi_stMain.tstTasks[u08TaskID]
+                    .stFifo.u08Tail];
+    eRetVal = RTCOS_ERR_NONE;
   }
-  return bRetVal;
+  else
+  {
+    eRetVal = RTCOS_ERR_MSG_EMPTY;
+  }
+  return eRetVal;
 }
+#endif /* RTCOS_ENABLE_MESSAGES */
 
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
 /** ***********************************************************************************************
-  * @brief      Run the task that has the highest priority and is ready
-  * @param      u08TaskID ID of the task to run
+  * @brief      Initialize the inline message ring of a task
+  * @param      u08TaskID ID of the task using this ring
   * @return     Nothing
   ********************************************************************************************** */
-static void _rtcos_run_ready_task(uint8_t u08TaskID)
+static void _rtcos_ring_init(uint8_t u08TaskID)
 {
-  uint32_t u32UnhandledEvents;
-  uint32_t u32CurrentEvents;
-
-  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
-  {
-    RTCOS_ENTER_CRITICAL_SECTION();
-    RTCOSi_stMain.u08CurrentTaskID = u08TaskID;
-    u32CurrentEvents = RTCOSi_stMain.tstTasks[RTCOSi_stMain.u08CurrentTaskID].u32EventFlags;
-    RTCOSi_stMain.tstTasks[RTCOSi_stMain.u08CurrentTaskID].u32EventFlags = 0;
-    RTCOS_EXIT_CRITICAL_SECTION();
-    u32UnhandledEvents = (RTCOSi_stMain.tstTasks[RTCOSi_stMain.u08CurrentTaskID].pfTaskHandlerCb)
-                         (u32CurrentEvents,
-#ifdef RTCOS_ENABLE_MESSAGES
-                         _rtcos_fifo_count(RTCOSi_stMain.u08CurrentTaskID),
-#else
-                         0,
-#endif /* RTCOS_ENABLE_MESSAGES */
-                         RTCOSi_stMain.tstTasks[RTCOSi_stMain.u08CurrentTaskID].pvArg);
-    RTCOS_ENTER_CRITICAL_SECTION();
-    RTCOSi_stMain.tstTasks[RTCOSi_stMain.u08CurrentTaskID].u32EventFlags |= u32UnhandledEvents;
-    RTCOS_EXIT_CRITICAL_SECTION();
-  }
+  RTCOSi_stMain.tstTasks[u08TaskID].stRing.u16Head = 0;
+  RTCOSi_stMain.tstTasks[u08TaskID].stRing.u16Tail = 0;
+  RTCOSi_stMain.tstTasks[u08TaskID].stRing.u16Used = 0;
+  RTCOSi_stMain.tstTasks[u08TaskID].stRing.u16Reserved = 0;
+  RTCOSi_stMain.tstTasks[u08TaskID].stRing.u16ReservedOffset = 0;
 }
 
 /** ***********************************************************************************************
-  * @brief      Search for a used event that has the requested task ID and event flag
-  * @param      u08TaskID ID of the task using this fifo
-  * @param      u32EventFlags Bit feild event
-  * @param      pu08FoundEventIdx This will hold the index the event if found
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Check if the ring of a certain task holds no committed message
+  * @param      u08TaskID ID of the task using this ring
+  * @return     true if empty, else false
   ********************************************************************************************** */
-static rtcos_status_t _rtcos_find_future_event(uint8_t u08TaskID,
-                                               uint32_t u32EventFlags,
-                                               uint8_t *pu08FoundEventIdx)
+static bool _rtcos_ring_empty(uint8_t u08TaskID)
 {
-  uint8_t u08Index;
-  rtcos_status_t eRetVal;
-
-  eRetVal = RTCOS_ERR_NOT_FOUND;
-  for(u08Index = 0; u08Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u08Index)
-  {
-    if((true == RTCOSi_stMain.tstFutureEvents[u08Index].bInUse) &&
-       (RTCOSi_stMain.tstFutureEvents[u08Index].u08TaskID == u08TaskID) && 
-       (RTCOSi_stMain.tstFutureEvents[u08Index].u32EventFlags == u32EventFlags))
-    {
-      *pu08FoundEventIdx = u08Index;
-      eRetVal = RTCOS_ERR_NONE;
-      break;
-    }
-  }
-  return eRetVal;
+  return (0 == RTCOSi_stMain.tstTasks[u08TaskID].stRing.u16Used)?true:false;
 }
 
 /** ***********************************************************************************************
-  * @brief      Search for a used event that has the requested task ID and event flag and delete it
-  * @param      u08TaskID ID of the task using this fifo
-  * @param      u32EventFlags Bit feild event
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Get the length field of the message header found at an offset of a ring
+  * @param      pstRing Pointer to the ring
+  * @param      u16Offset Offset of the header, aligned on 4 bytes
+  * @return     Pointer to the length field
   ********************************************************************************************** */
-static rtcos_status_t _rtcos_delete_future_event(uint8_t u08TaskID, uint32_t u32EventFlags)
+static uint16_t *_rtcos_ring_header(rtcos_ring_t *pstRing, uint16_t u16Offset)
 {
-  rtcos_status_t eRetVal;
-  uint8_t u08FoundEventIdx;
+  return (uint16_t *)&pstRing->tu32Data[u16Offset / 4];
+}
 
-  eRetVal = _rtcos_find_future_event(u08TaskID, u32EventFlags, &u08FoundEventIdx);
-  if(RTCOS_ERR_NONE == eRetVal)
+/** ***********************************************************************************************
+  * @brief      Get the payload of the message found at an offset of a ring
+  * @param      pstRing Pointer to the ring
+  * @param      u16Offset Offset of the message header, aligned on 4 bytes
+  * @return     Pointer to the payload
+  ********************************************************************************************** */
+static void *_rtcos_ring_payload(rtcos_ring_t *pstRing, uint16_t u16Offset)
+{
+  return &pstRing->tu32Data[(u16Offset + RTCOS_RING_HEADER_SIZE) / 4];
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the offset of the oldest message of a non empty ring, skipping the end of the
+  *             ring when the producer wrapped, must be called inside a critical section
+  * @param      pstRing Pointer to the ring
+  * @return     Offset of the oldest message header
+  ********************************************************************************************** */
+static uint16_t _rtcos_ring_oldest(rtcos_ring_t *pstRing)
+{
+  uint16_t u16RetVal;
+
+  u16RetVal = pstRing->u16Tail;
+  if(((RTCOS_MESSAGE_RING_SIZE - u16RetVal) < RTCOS_RING_HEADER_SIZE) ||
+     (RTCOS_RING_WRAP_MARK == *_rtcos_ring_header(pstRing, u16RetVal)))
   {
-    RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].bInUse = false;
-    if(RTCOSi_stMain.u08FutureEventsCount > 0)
-    {
-      RTCOSi_stMain.u08FutureEventsCount--;
-    }
+    u16RetVal = 0;
   }
-  return eRetVal;
+  return u16RetVal;
 }
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
 
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
 /** ***********************************************************************************************
-  * @brief      Search for an unused event
-  * @param      pu08FoundEventIdx ID of the the found unused event
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Chain the blocks of every pool in its free list
+  * @return     Nothing
   ********************************************************************************************** */
-static rtcos_status_t _rtcos_find_empty_future_event_index(uint8_t *pu08FoundEventIdx)
+static void _rtcos_msg_pools_init(void)
 {
-  uint8_t u08Index;
-  rtcos_status_t eRetVal;
+  rtcos_msg_block_t *pstBlock;
+  uint8_t *pu08Block;
+  uint16_t u16Index;
+  uint8_t u08Pool;
 
-  eRetVal = RTCOS_ERR_NOT_FOUND;
-  for(u08Index = 0; u08Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u08Index)
+  pu08Block = (uint8_t *)RTCOSi_stMain.tu64MsgArena;
+  for(u08Pool = 0; u08Pool < RTCOS_MSG_POOLS_COUNT; ++u08Pool)
   {
-    if(false == RTCOSi_stMain.tstFutureEvents[u08Index].bInUse)
+    RTCOSi_stMain.tpstMsgFreeLists[u08Pool] = NULL;
+    for(u16Index = 0; u16Index < RTCOSi_tstMsgPools[u08Pool].u16BlocksCount; ++u16Index)
     {
-      *pu08FoundEventIdx = u08Index;
-      eRetVal = RTCOS_ERR_NONE;
-      break;
+      pstBlock = (rtcos_msg_block_t *)pu08Block;
+      pstBlock->u08Pool = u08Pool;
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+      atomic_init(&pstBlock->u16RefCount, 0);
+#else
+      pstBlock->u16RefCount = 0;
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+      pstBlock->pstNext = RTCOSi_stMain.tpstMsgFreeLists[u08Pool];
+      RTCOSi_stMain.tpstMsgFreeLists[u08Pool] = pstBlock;
+      pu08Block += RTCOS_MSG_BLOCK_STRIDE(RTCOSi_tstMsgPools[u08Pool].u16BlockSize);
     }
   }
-  return eRetVal;
 }
 
 /** ***********************************************************************************************
-  * @brief      Schedule a future event if there is space in the future event
-  *             array. First look if there is already a future event
-  *             in the array, if not find an empty spot.
-  * @param      u08TaskID ID of the task using this event
-  * @param      u32EventFlags Bit feild event
-  * @param      u32EventDelay How long to wait before sending event, if 0 send immediately
-  * @param      bPeriodicEvent Indicates whether to send this event periodically or not
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Get the pool block holding a message. A pointer inside the arena must be the
+  *             message of a block of its pool, not a pointer into it, and the block must be
+  *             allocated
+  * @param      pvMsg Message pointer
+  * @param      ppstBlock Block of the message, NULL if the message does not come from a pool
+  * @return     RTCOS_ERR_INVALID_MSG if the pointer is inside the arena but is not the message
+  *             of an allocated block, else RTCOS_ERR_NONE
   ********************************************************************************************** */
-static rtcos_status_t _rtcos_add_future_event(uint8_t u08TaskID,
-                                              uint32_t u32EventFlags,
-                                              uint32_t u32EventDelay,
-                                              bool bPeriodicEvent)
+static rtcos_status_t _rtcos_msg_get_block(void *pvMsg, rtcos_msg_block_t **ppstBlock)
 {
-  uint8_t u08FoundEventIdx;
+  uintptr_t uOffset;
+  uintptr_t uPoolSize;
+  uint16_t u16Stride;
+  uint16_t u16RefCount;
+  uint8_t u08Pool;
   rtcos_status_t eRetVal;
 
-  RTCOS_ENTER_CRITICAL_SECTION();
-  eRetVal = _rtcos_find_future_event(u08TaskID, u32EventFlags, &u08FoundEventIdx);
-  if(RTCOS_ERR_NONE == eRetVal)
-  {
-    RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].u32EventDelay = u32EventDelay;
-  }
-  else
+  eRetVal = RTCOS_ERR_NONE;
+  *ppstBlock = NULL;
+  uOffset = (uintptr_t)((uint8_t *)pvMsg - (uint8_t *)RTCOSi_stMain.tu64MsgArena);
+  if(((uint8_t *)pvMsg >= (uint8_t *)RTCOSi_stMain.tu64MsgArena) &&
+     (uOffset < RTCOS_MSG_ARENA_SIZE))
   {
-    eRetVal = _rtcos_find_empty_future_event_index(&u08FoundEventIdx);
-    if(RTCOS_ERR_NONE == eRetVal)
+    eRetVal = RTCOS_ERR_INVALID_MSG;
+    /* Find the pool whose blocks hold the offset, then the block it points into */
+    for(u08Pool = 0; u08Pool < RTCOS_MSG_POOLS_COUNT; ++u08Pool)
     {
-      RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].bInUse = true;
-      RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].u32EventDelay = u32EventDelay;
-      RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].u08TaskID = u08TaskID;
-      RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].u32EventFlags = u32EventFlags;
-      ++RTCOSi_stMain.u08FutureEventsCount;
-      if(true == bPeriodicEvent)
-      {   
-        RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].u32ReloadDelay = u32EventDelay;
+      u16Stride = RTCOS_MSG_BLOCK_STRIDE(RTCOSi_tstMsgPools[u08Pool].u16BlockSize);
+      uPoolSize = (uintptr_t)u16Stride * RTCOSi_tstMsgPools[u08Pool].u16BlocksCount;
+      if(uOffset < uPoolSize)
+      {
+        if(RTCOS_MSG_HEADER_SIZE == (uOffset % u16Stride))
+        {
+          *ppstBlock = (rtcos_msg_block_t *)((uint8_t *)pvMsg - RTCOS_MSG_HEADER_SIZE);
+        }
+        break;
+      }
+      uOffset -= uPoolSize;
+    }
+    if(NULL != *ppstBlock)
+    {
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+      u16RefCount = atomic_load_explicit(&(*ppstBlock)->u16RefCount, memory_order_relaxed);
+#else
+      u16RefCount = (*ppstBlock)->u16RefCount;
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+      if(0 == u16RefCount)
+      {
+        *ppstBlock = NULL;
       }
       else
       {
-        RTCOSi_stMain.tstFutureEvents[u08FoundEventIdx].u32ReloadDelay = 0;
+        eRetVal = RTCOS_ERR_NONE;
       }
     }
   }
-  RTCOS_EXIT_CRITICAL_SECTION();
   return eRetVal;
 }
 
 /** ***********************************************************************************************
-  * @brief      Find if there are any set events
-  * @param      u32EventFlags Bit feild event
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Take one more reference on a pool message, must be called outside of a critical
+  *             section
+  * @param      pstBlock Block of the message
+  * @return     Nothing
   ********************************************************************************************** */
-static rtcos_status_t _rtcos_count_events(uint32_t u32EventFlags)
+static void _rtcos_msg_add_ref(rtcos_msg_block_t *pstBlock)
 {
-  return (u32EventFlags)?RTCOS_ERR_NONE:RTCOS_ERR_NO_EVENT;
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+  atomic_fetch_add_explicit(&pstBlock->u16RefCount, 1, memory_order_relaxed);
+#else
+  RTCOS_ENTER_CRITICAL_SECTION();
+  ++pstBlock->u16RefCount;
+  RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
 }
 
 /** ***********************************************************************************************
-  * @brief      Check the inputs to the event routines
-  * @param      u08TaskID ID of the task using this event
-  * @param      u32EventFlags Bit feild event
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Drop a reference on a pool message and give the block back to its pool with the
+  *             last one, must be called outside of a critical section
+  * @param      pstBlock Block of the message
+  * @return     RTCOS_ERR_ARG if the block is already free, else RTCOS_ERR_NONE
   ********************************************************************************************** */
-static rtcos_status_t _rtcos_check_event_input(uint8_t u08TaskID, uint32_t u32EventFlags)
+static rtcos_status_t _rtcos_msg_put_ref(rtcos_msg_block_t *pstBlock)
 {
+  uint16_t u16RefCount;
   rtcos_status_t eRetVal;
 
-  eRetVal = _rtcos_count_events(u32EventFlags);
-  if(RTCOS_ERR_NONE == eRetVal)
+  eRetVal = RTCOS_ERR_NONE;
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+  u16RefCount = atomic_load_explicit(&pstBlock->u16RefCount, memory_order_relaxed);
+  while((0 != u16RefCount) &&
+        (false == atomic_compare_exchange_weak_explicit(&pstBlock->u16RefCount, &u16RefCount,
+                                                        (uint16_t)(u16RefCount - 1),
+                                                        memory_order_acq_rel,
+                                                        memory_order_relaxed)));
+  RTCOS_ENTER_CRITICAL_SECTION();
+#else
+  RTCOS_ENTER_CRITICAL_SECTION();
+  u16RefCount = pstBlock->u16RefCount;
+  if(0 != u16RefCount)
   {
-    if(u08TaskID >= RTCOSi_stMain.u08TasksCount)
-    {
-      eRetVal = RTCOS_ERR_INVALID_TASK;
-    }
+    --pstBlock->u16RefCount;
+  }
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+  if(0 == u16RefCount)
+  {
+    eRetVal = RTCOS_ERR_ARG;
   }
+  else if(1 == u16RefCount)
+  {
+    pstBlock->pstNext = RTCOSi_stMain.tpstMsgFreeLists[pstBlock->u08Pool];
+    RTCOSi_stMain.tpstMsgFreeLists[pstBlock->u08Pool] = pstBlock;
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
   return eRetVal;
 }
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
 
-/*-----------------------------------------------------------------------------------------------*/
-/* Exported functions                                                                            */
-/*-----------------------------------------------------------------------------------------------*/
 /** ***********************************************************************************************
-  * @brief      Initialize rtcos main context, this should be called before any other os calls
+  * @brief      Count the leading zero bits of a 32 bits value.
+  *             A port can provide its own instruction through RTCOS_CLZ (e.g. __CLZ on Cortex-M3)
+  * @param      u32Value Value to inspect, must not be 0
+  * @return     Number of leading zero bits
+  ********************************************************************************************** */
+static uint8_t _rtcos_clz(uint32_t u32Value)
+{
+#if defined(RTCOS_CLZ)
+  return (uint8_t)RTCOS_CLZ(u32Value);
+#elif defined(__GNUC__)
+  return (uint8_t)(__builtin_clzl((unsigned long)u32Value) - ((sizeof(unsigned long) * 8) - 32));
+#else
+  uint8_t u08Count;
+
+  u08Count = 0;
+  if(0 == (u32Value & 0xFFFF0000uL)) { u08Count += 16; u32Value <<= 16; }
+  if(0 == (u32Value & 0xFF000000uL)) { u08Count += 8;  u32Value <<= 8;  }
+  if(0 == (u32Value & 0xF0000000uL)) { u08Count += 4;  u32Value <<= 4;  }
+  if(0 == (u32Value & 0xC0000000uL)) { u08Count += 2;  u32Value <<= 2;  }
+  if(0 == (u32Value & 0x80000000uL)) { u08Count += 1; }
+  return u08Count;
+#endif /* RTCOS_CLZ */
+}
+
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+/** ***********************************************************************************************
+  * @brief      Add posts to the pending count of a counted event, the count saturates at
+  *             RTCOS_EVENT_COUNT_MAX. Must be called inside a critical section unless
+  *             RTCOS_ENABLE_ISR_EVENTS makes the counts atomic
+  * @param      u08TaskID ID of the task receiving the event
+  * @param      u08Event Bit position of the event
+  * @param      u08Count Number of posts to add
   * @return     Nothing
   ********************************************************************************************** */
-void rtcos_init(void)
+static void _rtcos_event_count_add(uint8_t u08TaskID, uint8_t u08Event, uint8_t u08Count)
 {
-  uint8_t u08Index;
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+  uint8_t u08Old;
+  uint8_t u08New;
 
-  for(u08Index = 0; u08Index < RTCOS_MAX_TASKS_COUNT; ++u08Index)
-  {
-    RTCOSi_stMain.tstTasks[u08Index].pfTaskHandlerCb = NULL;
-    RTCOSi_stMain.tstTasks[u08Index].u32EventFlags = 0;
-#ifdef RTCOS_ENABLE_MESSAGES
-    _rtcos_fifo_init(u08Index);
-#endif /* RTCOS_ENABLE_MESSAGES */
-  }
-  for(u08Index = 0; u08Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u08Index)
+  u08Old = atomic_load_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event],
+                                memory_order_relaxed);
+  do
   {
-    RTCOSi_stMain.tstFutureEvents[u08Index].bInUse = false;
-    RTCOSi_stMain.tstFutureEvents[u08Index].u08TaskID = 0;
-    RTCOSi_stMain.tstFutureEvents[u08Index].u32EventFlags = 0;
-    RTCOSi_stMain.tstFutureEvents[u08Index].u32EventDelay = 0;
-    RTCOSi_stMain.tstFutureEvents[u08Index].u32ReloadDelay = 0;
-  }
-#ifdef RTCOS_ENABLE_TIMERS
-  for(u08Index = 0; u08Index < RTCOS_MAX_TIMERS_COUNT; ++u08Index)
-  {
-    RTCOSi_stMain.tstTimers[u08Index].u32StartTickCount = 0;
-    RTCOSi_stMain.tstTimers[u08Index].u32TickDelay = 0;
-    RTCOSi_stMain.tstTimers[u08Index].bInUse = false;
-    RTCOSi_stMain.tstTimers[u08Index].pfTimerCb = NULL;
-    RTCOSi_stMain.tstTimers[u08Index].pvArg = NULL;
+    u08New = (u08Old > (RTCOS_EVENT_COUNT_MAX - u08Count)) ?
+             RTCOS_EVENT_COUNT_MAX : (uint8_t)(u08Old + u08Count);
   }
-  RTCOSi_stMain.u08TimersCount = 0;
-#endif /* RTCOS_ENABLE_TIMERS */
-  RTCOSi_stMain.u08CurrentTaskID = 0;
-  RTCOSi_stMain.u32SysTicksCount = 0;
-  RTCOSi_stMain.u08FutureEventsCount = 0;
-  RTCOSi_stMain.pfIdleHandler = NULL;
+  while(!atomic_compare_exchange_weak_explicit(&RTCOSi_stMain
+                                                  .tstTasks[u08TaskID]
+                                                    .tu08EventCounts[u08Event],
+                                               &u08Old, u08New,
+                                               memory_order_relaxed, memory_order_relaxed));
+#else
+  uint8_t u08Old;
+
+  u08Old = RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event];
+  RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event] =
+    (u08Old > (RTCOS_EVENT_COUNT_MAX - u08Count)) ?
+    RTCOS_EVENT_COUNT_MAX : (uint8_t)(u08Old + u08Count);
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
 }
 
 /** ***********************************************************************************************
-  * @brief      Register a task handler if there is space
-  * @param      pfTaskHandler task handler function
-  * @param      u08TaskID ID of this task
-  * @param      pvArg Task argument
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Count one post of every counted event among the posted flags, must be called
+  *             before the flags are set
+  * @param      u08TaskID ID of the task receiving the events
+  * @param      u32EventFlags Posted event flags
+  * @return     Nothing
   ********************************************************************************************** */
-rtcos_status_t rtcos_register_task_handler(pf_os_task_handler_t pfTaskHandler,
-                                           uint8_t u08TaskID,
-                                           void *pvArg)
+static void _rtcos_event_counts_post(uint8_t u08TaskID, uint32_t u32EventFlags)
 {
-  rtcos_status_t eRetVal;
+  uint8_t u08Event;
 
-  if(u08TaskID < RTCOS_MAX_TASKS_COUNT)
-  {
-    if(RTCOSi_stMain.tstTasks[u08TaskID].pfTaskHandlerCb != NULL)
-    {
-      eRetVal = RTCOS_ERR_IN_USE;
-    }
-    else
-    {
-      RTCOSi_stMain.tstTasks[u08TaskID].pfTaskHandlerCb = pfTaskHandler;
-      RTCOSi_stMain.tstTasks[u08TaskID].pvArg = pvArg;
-      ++RTCOSi_stMain.u08TasksCount;
-      eRetVal = RTCOS_ERR_NONE;
-    }
-  }
-  else
+  u32EventFlags &= RTCOSi_stMain.tstTasks[u08TaskID].u32CountedEvents;
+  while(0 != u32EventFlags)
   {
-    eRetVal = RTCOS_ERR_OUT_OF_RANGE;
+    u08Event = (uint8_t)(31 - _rtcos_clz(u32EventFlags));
+    u32EventFlags &= ~((uint32_t)1 << u08Event);
+    _rtcos_event_count_add(u08TaskID, u08Event, 1);
   }
-  return eRetVal;
 }
 
 /** ***********************************************************************************************
-  * @brief      Register an idle handler to be called when the system is idle
-  * @param      pfIdleHandler idle handler function
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Move the pending counts of the taken events to the running handler call,
+  *             must be called right after the event flags are taken
+  * @param      u08TaskID ID of the task being dispatched
+  * @param      u32EventFlags Events given to the handler
+  * @return     Nothing
   ********************************************************************************************** */
-rtcos_status_t rtcos_register_idle_handler(pf_os_idle_handler_t pfIdleHandler)
+static void _rtcos_event_counts_take(uint8_t u08TaskID, uint32_t u32EventFlags)
 {
-  rtcos_status_t eRetVal;
+  uint8_t u08Event;
 
-  if(pfIdleHandler)
-  {
-    RTCOSi_stMain.pfIdleHandler = pfIdleHandler; 
-    eRetVal = RTCOS_ERR_NONE;
-  }
-  else
+  RTCOSi_stMain.tstTasks[u08TaskID].u32RunEvents = u32EventFlags;
+  u32EventFlags &= RTCOSi_stMain.tstTasks[u08TaskID].u32CountedEvents;
+  while(0 != u32EventFlags)
   {
-    eRetVal = RTCOS_ERR_ARG;
+    u08Event = (uint8_t)(31 - _rtcos_clz(u32EventFlags));
+    u32EventFlags &= ~((uint32_t)1 << u08Event);
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+    RTCOSi_stMain.tstTasks[u08TaskID].tu08RunCounts[u08Event] =
+      atomic_exchange_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event], 0,
+                               memory_order_relaxed);
+#else
+    RTCOSi_stMain.tstTasks[u08TaskID].tu08RunCounts[u08Event] =
+      RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event];
+    RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event] = 0;
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
   }
-  return eRetVal;
 }
 
-#ifdef RTCOS_ENABLE_MESSAGES
 /** ***********************************************************************************************
-  * @brief      Send a message to a task
-  * @param      u08TaskID ID of the task which will receive the message
-  * @param      pvMsg Pointer on the message to send
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Give the counts of the events left unhandled back to the pending counts,
+  *             must be called before the unhandled flags are set again
+  * @param      u08TaskID ID of the task that was dispatched
+  * @param      u32EventFlags Events returned as unhandled by the handler
+  * @return     Nothing
   ********************************************************************************************** */
-rtcos_status_t rtcos_send_message(uint8_t u08TaskID, void *pvMsg)
+static void _rtcos_event_counts_restore(uint8_t u08TaskID, uint32_t u32EventFlags)
 {
-  rtcos_status_t eRetVal;
+  uint8_t u08Event;
 
-  if(pvMsg)
-  {
-    if(u08TaskID < RTCOSi_stMain.u08TasksCount)
-    {
-      RTCOS_ENTER_CRITICAL_SECTION();
-      eRetVal = _rtcos_fifo_push(u08TaskID, pvMsg);
-      RTCOS_EXIT_CRITICAL_SECTION();
-    }
-    else
-    {
-      eRetVal = RTCOS_ERR_INVALID_TASK;
-    }
-  }
-  else
+  u32EventFlags &= RTCOSi_stMain.tstTasks[u08TaskID].u32RunEvents &
+                   RTCOSi_stMain.tstTasks[u08TaskID].u32CountedEvents;
+  while(0 != u32EventFlags)
   {
-    eRetVal = RTCOS_ERR_ARG;
+    u08Event = (uint8_t)(31 - _rtcos_clz(u32EventFlags));
+    u32EventFlags &= ~((uint32_t)1 << u08Event);
+    _rtcos_event_count_add(u08TaskID, u08Event,
+                           RTCOSi_stMain.tstTasks[u08TaskID].tu08RunCounts[u08Event]);
   }
-  return eRetVal;
+  RTCOSi_stMain.tstTasks[u08TaskID].u32RunEvents = 0;
 }
 
 /** ***********************************************************************************************
-  * @brief      Send a message to all tasks
-  * @param      pvMsg Pointer on the message to send
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Drop the pending counts of cleared events, must be called after the flags are
+  *             cleared
+  * @param      u08TaskID ID of the task using the events
+  * @param      u32EventFlags Cleared event flags
+  * @return     Nothing
   ********************************************************************************************** */
-rtcos_status_t rtcos_broadcast_message(void *pvMsg)
+static void _rtcos_event_counts_clear(uint8_t u08TaskID, uint32_t u32EventFlags)
 {
-  uint8_t u08Index;
-  rtcos_status_t eRetVal;
+  uint8_t u08Event;
 
-  eRetVal = RTCOS_ERR_NONE;
-  if(pvMsg)
-  {
-    for(u08Index = 0; u08Index < RTCOSi_stMain.u08TasksCount; ++u08Index)
-    {
-      eRetVal |= rtcos_send_message(u08Index, pvMsg);
-    }
-  }
-  else
+  while(0 != u32EventFlags)
   {
-    eRetVal = RTCOS_ERR_ARG;
+    u08Event = (uint8_t)(31 - _rtcos_clz(u32EventFlags));
+    u32EventFlags &= ~((uint32_t)1 << u08Event);
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+    atomic_store_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event], 0,
+                          memory_order_relaxed);
+#else
+    RTCOSi_stMain.tstTasks[u08TaskID].tu08EventCounts[u08Event] = 0;
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
   }
-  return eRetVal;
 }
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
 
+#if defined(RTCOS_ENABLE_STATS) || defined(RTCOS_ENABLE_TIME64)
 /** ***********************************************************************************************
-  * @brief      Retrieve a message from inside a task handler
-  * @param      ppvMsg Pointer on a pointer to retrieved message
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Start updating data guarded by a sequence, readers retry while it is odd
+  * @param      pu32Sequence Sequence guarding the data
+  * @return     Nothing
   ********************************************************************************************** */
-rtcos_status_t rtcos_get_message(void **ppvMsg)
+static void _rtcos_seq_write_begin(_Atomic uint32_t *pu32Sequence)
 {
-  rtcos_status_t eRetVal;
+  atomic_store_explicit(pu32Sequence,
+                        atomic_load_explicit(pu32Sequence, memory_order_relaxed) + 1,
+                        memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+}
+
+/** ***********************************************************************************************
+  * @brief      Publish the data updated since _rtcos_seq_write_begin()
+  * @param      pu32Sequence Sequence guarding the data
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_seq_write_end(_Atomic uint32_t *pu32Sequence)
+{
+  atomic_store_explicit(pu32Sequence,
+                        atomic_load_explicit(pu32Sequence, memory_order_relaxed) + 1,
+                        memory_order_release);
+}
+#endif /* RTCOS_ENABLE_STATS || RTCOS_ENABLE_TIME64 */
+
+#ifdef RTCOS_ENABLE_STATS
+/** ***********************************************************************************************
+  * @brief      Count the bits set in a 32 bits value
+  * @param      u32Value Value to look at
+  * @return     Number of bits set
+  ********************************************************************************************** */
+static uint8_t _rtcos_count_bits(uint32_t u32Value)
+{
+  uint8_t u08Count;
 
-  if(RTCOSi_stMain.u08CurrentTaskID < RTCOSi_stMain.u08TasksCount)
+  for(u08Count = 0; 0 != u32Value; ++u08Count)
   {
-    RTCOS_ENTER_CRITICAL_SECTION();
-    eRetVal = _rtcos_fifo_pop(RTCOSi_stMain.u08CurrentTaskID, ppvMsg);
-    RTCOS_EXIT_CRITICAL_SECTION();
+    u32Value &= u32Value - 1;
   }
-  else
+  return u08Count;
+}
+
+/** ***********************************************************************************************
+  * @brief      Account a handler call in the statistics of its task. Only the thread running the
+  *             task writes them so that no lock is needed.
+  * @param      u08TaskID ID of the task whose handler returned
+  * @param      u32EventFlags Events given to the handler
+  * @param      u32StartTime Timestamp taken right before calling the handler
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_stats_record_run(uint8_t u08TaskID,
+                                    uint32_t u32EventFlags,
+                                    uint32_t u32StartTime)
+{
+  rtcos_task_t *pstTask;
+  uint32_t u32RunTime;
+
+  u32RunTime = (uint32_t)RTCOS_PORT_TIMESTAMP() - u32StartTime;
+  pstTask = &RTCOSi_stMain.tstTasks[u08TaskID];
+  _rtcos_seq_write_begin(&pstTask->u32StatsSequence);
+  ++pstTask->stStats.u32DispatchCount;
+  pstTask->stStats.u32EventsCount += _rtcos_count_bits(u32EventFlags);
+  pstTask->stStats.u32MessagesCount += pstTask->u32MessagesTaken;
+  pstTask->stStats.u64TotalRunTime += u32RunTime;
+  if(u32RunTime > pstTask->stStats.u32MaxRunTime)
   {
-    eRetVal = RTCOS_ERR_INVALID_TASK;
+    pstTask->stStats.u32MaxRunTime = u32RunTime;
   }
-  return eRetVal;
+  _rtcos_seq_write_end(&pstTask->u32StatsSequence);
+  pstTask->u32MessagesTaken = 0;
 }
-#endif /* RTCOS_ENABLE_MESSAGES */
 
-#ifdef RTCOS_ENABLE_TIMERS
 /** ***********************************************************************************************
-  * @brief      Create an os software timer
-  * @param      ePeriodType timer type as defined in ::rtcos_timer_type_t
-  * @param      pfTimerCb Timer callback function
-  * @param      pvArg Additional argument passed to the timer callback
-  * @return     ID of the created timer or error
+  * @brief      Account the time elapsed since the previous pass of a scheduling loop
+  * @param      u08Loop Index of the scheduling loop, the worker ID with RTCOS_ENABLE_WORKERS
+  * @param      bBusy true if the pass ran a task or processed ticks, false if it was idle
+  * @param      pu32PassTime Timestamp of the previous pass, updated to the current one
+  * @return     Nothing
   ********************************************************************************************** */
-int8_t rtcos_create_timer(rtcos_timer_type_t ePeriodType, pf_os_timer_cb_t pfTimerCb, void *pvArg)
+static void _rtcos_stats_record_pass(uint8_t u08Loop, bool bBusy, uint32_t *pu32PassTime)
 {
-  int8_t s08RetVal;
+  rtcos_loop_time_t *pstLoop;
+  uint32_t u32Now;
 
-  RTCOS_ENTER_CRITICAL_SECTION();
-  if(RTCOSi_stMain.u08TimersCount >= RTCOS_MAX_TIMERS_COUNT)
+  u32Now = (uint32_t)RTCOS_PORT_TIMESTAMP();
+  pstLoop = &RTCOSi_stMain.tstLoopTimes[u08Loop];
+  _rtcos_seq_write_begin(&pstLoop->u32Sequence);
+  if(true == bBusy)
   {
-    s08RetVal = RTCOS_ERR_OUT_OF_RESOURCES;
+    pstLoop->u64BusyTime += (uint32_t)(u32Now - *pu32PassTime);
   }
   else
   {
-    RTCOSi_stMain.tstTimers[RTCOSi_stMain.u08TimersCount].ePeriodType = ePeriodType;
-    RTCOSi_stMain.tstTimers[RTCOSi_stMain.u08TimersCount].pfTimerCb = pfTimerCb;
-    RTCOSi_stMain.tstTimers[RTCOSi_stMain.u08TimersCount].pvArg = pvArg;
-    s08RetVal = RTCOSi_stMain.u08TimersCount++;
+    pstLoop->u64IdleTime += (uint32_t)(u32Now - *pu32PassTime);
   }
-  RTCOS_EXIT_CRITICAL_SECTION();
-  return s08RetVal;
+  _rtcos_seq_write_end(&pstLoop->u32Sequence);
+  *pu32PassTime = u32Now;
 }
+#endif /* RTCOS_ENABLE_STATS */
 
+#ifdef RTCOS_ENABLE_TRACE
 /** ***********************************************************************************************
-  * @brief      Start os software timer
-  * @param      u08TimerID ID of the timer to start
-  * @param      u32PeriodInTicks Timer period in ticks
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Append a record to the trace ring buffer, from any context: the slot is reserved
+  *             with an atomic increment and the oldest record is overwritten when the ring is full
+  * @param      u08Kind Kind of the record as defined in ::rtcos_trace_kind_t
+  * @param      u08TaskID Related task or RTCOS_TRACE_NO_TASK
+  * @param      u32Value Depends on the kind of the record
+  * @return     Nothing
   ********************************************************************************************** */
-rtcos_status_t rtcos_start_timer(uint8_t u08TimerID, uint32_t u32PeriodInTicks)
+static void _rtcos_trace_record(uint8_t u08Kind, uint8_t u08TaskID, uint32_t u32Value)
 {
-  rtcos_status_t eRetVal;
+  rtcos_trace_record_t *pstRecord;
+  uint32_t u32Position;
 
-  RTCOS_ENTER_CRITICAL_SECTION();
-  if(u08TimerID >= RTCOS_MAX_TIMERS_COUNT)
-  {
-    eRetVal = RTCOS_ERR_OUT_OF_RESOURCES;
-  }
-  else
+  if(true == atomic_load_explicit(&RTCOSi_stMain.bTraceEnabled, memory_order_relaxed))
   {
-    RTCOSi_stMain.tstTimers[u08TimerID].u32TickDelay = u32PeriodInTicks;
-    RTCOSi_stMain.tstTimers[u08TimerID].u32StartTickCount = RTCOSi_stMain.u32SysTicksCount;
-    RTCOSi_stMain.tstTimers[u08TimerID].bInUse = true;
-    eRetVal = RTCOS_ERR_NONE;
+    u32Position = atomic_fetch_add_explicit(&RTCOSi_stTrace.u32Head, 1, memory_order_relaxed);
+    pstRecord = &RTCOSi_stTrace.tstRecords[u32Position & RTCOS_TRACE_INDEX_MASK];
+    pstRecord->u32Timestamp = (uint32_t)RTCOS_PORT_TIMESTAMP();
+    pstRecord->u32Value = u32Value;
+    pstRecord->u08Kind = u08Kind;
+    pstRecord->u08TaskID = u08TaskID;
+    /* Published last: the release fence keeps the payload stores ahead of the sequence store,
+     * the decoder drops the records whose sequence does not match their position */
+    atomic_thread_fence(memory_order_release);
+    pstRecord->u16Sequence = (uint16_t)u32Position;
   }
-  RTCOS_EXIT_CRITICAL_SECTION();
-  return eRetVal;
 }
+#endif /* RTCOS_ENABLE_TRACE */
 
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
 /** ***********************************************************************************************
-  * @brief      Start os software timer
-  * @param      u08TimerID ID of the timer to stop
-  * @return     Status as defined in ::rtcos_status_t
+  * @brief      Check a handler call against the budget of its task, an overrun is counted with
+  *             the events that were handled and then reported to RTCOS_PORT_BUDGET_OVERRUN()
+  * @param      u08TaskID ID of the task whose handler returned
+  * @param      u32EventFlags Events given to the handler
+  * @param      u32StartTime Timestamp taken right before calling the handler
+  * @return     Nothing
   ********************************************************************************************** */
-rtcos_status_t rtcos_stop_timer(uint8_t u08TimerID)
+static void _rtcos_budget_check(uint8_t u08TaskID, uint32_t u32EventFlags, uint32_t u32StartTime)
 {
-  rtcos_status_t eRetVal;
+  rtcos_task_overruns_t *pstOverruns;
+  uint32_t u32RunTime;
+  bool bOverrun;
 
+  u32RunTime = (uint32_t)RTCOS_PORT_TIMESTAMP() - u32StartTime;
+  pstOverruns = &RTCOSi_stMain.tstTasks[u08TaskID].stOverruns;
   RTCOS_ENTER_CRITICAL_SECTION();
-  if(u08TimerID >= RTCOS_MAX_TIMERS_COUNT)
+  bOverrun = (0 != pstOverruns->u32Budget) && (u32RunTime > pstOverruns->u32Budget);
+  if(true == bOverrun)
   {
-    eRetVal = RTCOS_ERR_OUT_OF_RESOURCES;
+    ++pstOverruns->u32OverrunsCount;
+    pstOverruns->u32LastEventFlags = u32EventFlags;
+    pstOverruns->u32LastRunTime = u32RunTime;
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
+  if(true == bOverrun)
+  {
+    RTCOS_PORT_BUDGET_OVERRUN(u08TaskID, u32EventFlags, u32RunTime);
+  }
+}
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+
+#ifdef RTCOS_ENABLE_WORKERS
+/** ***********************************************************************************************
+  * @brief      Push a task on the bottom of a deque, only the owner worker may call this
+  * @param      pstDeque Deque of the calling worker
+  * @param      u08TaskID ID of the queued task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_deque_push(rtcos_deque_t *pstDeque, uint8_t u08TaskID)
+{
+  uint32_t u32Bottom;
+
+  u32Bottom = atomic_load_explicit(&pstDeque->u32Bottom, memory_order_relaxed);
+  atomic_store_explicit(&pstDeque->tu08Buffer[u32Bottom & RTCOS_DEQUE_INDEX_MASK], u08TaskID,
+                        memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&pstDeque->u32Bottom, u32Bottom + 1, memory_order_relaxed);
+}
+
+/** ***********************************************************************************************
+  * @brief      Pop the most recently pushed task of a deque, only the owner worker may call this
+  * @param      pstDeque Deque of the calling worker
+  * @param      pu08TaskID This will hold the ID of the popped task
+  * @return     true if a task is popped, else false
+  ********************************************************************************************** */
+static bool _rtcos_deque_pop(rtcos_deque_t *pstDeque, uint8_t *pu08TaskID)
+{
+  uint32_t u32Bottom;
+  uint32_t u32Top;
+  bool bRetVal;
+
+  bRetVal = false;
+  u32Bottom = atomic_load_explicit(&pstDeque->u32Bottom, memory_order_relaxed) - 1;
+  atomic_store_explicit(&pstDeque->u32Bottom, u32Bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  u32Top = atomic_load_explicit(&pstDeque->u32Top, memory_order_relaxed);
+  if((int32_t)(u32Bottom - u32Top) >= 0)
+  {
+    *pu08TaskID = atomic_load_explicit(&pstDeque->tu08Buffer[u32Bottom & RTCOS_DEQUE_INDEX_MASK],
+                                       memory_order_relaxed);
+    bRetVal = true;
+    if(u32Top == u32Bottom)
+    {
+      /* Last task of the deque, a thief may be taking it at the same time */
+      bRetVal = atomic_compare_exchange_strong_explicit(&pstDeque->u32Top, &u32Top, u32Top + 1,
+                                                        memory_order_seq_cst, memory_order_relaxed);
+      atomic_store_explicit(&pstDeque->u32Bottom, u32Bottom + 1, memory_order_relaxed);
+    }
+  }
+  else
+  {
+    atomic_store_explicit(&pstDeque->u32Bottom, u32Bottom + 1, memory_order_relaxed);
+  }
+  return bRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Steal the oldest task of another worker's deque
+  * @param      pstDeque Deque of the victim worker
+  * @param      pu08TaskID This will hold the ID of the stolen task
+  * @return     true if a task is stolen, else false
+  ********************************************************************************************** */
+static bool _rtcos_deque_steal(rtcos_deque_t *pstDeque, uint8_t *pu08TaskID)
+{
+  uint32_t u32Bottom;
+  uint32_t u32Top;
+  bool bRetVal;
+
+  bRetVal = false;
+  u32Top = atomic_load_explicit(&pstDeque->u32Top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  u32Bottom = atomic_load_explicit(&pstDeque->u32Bottom, memory_order_acquire);
+  if((int32_t)(u32Bottom - u32Top) > 0)
+  {
+    *pu08TaskID = atomic_load_explicit(&pstDeque->tu08Buffer[u32Top & RTCOS_DEQUE_INDEX_MASK],
+                                       memory_order_relaxed);
+    bRetVal = atomic_compare_exchange_strong_explicit(&pstDeque->u32Top, &u32Top, u32Top + 1,
+                                                      memory_order_seq_cst, memory_order_relaxed);
+  }
+  return bRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Take the highest priority task queued from outside the workers
+  * @param      u08MaxBand Lowest priority band accepted
+  * @param      pu08TaskID This will hold the ID of the taken task
+  * @return     true if a task is taken, else false
+  ********************************************************************************************** */
+static bool _rtcos_claim_pending_task(uint8_t u08MaxBand, uint8_t *pu08TaskID)
+{
+  uint8_t u08Word;
+  uint8_t u08TaskID;
+  uint32_t u32Pending;
+  uint32_t u32Skipped;
+  bool bSearching;
+  bool bRetVal;
+
+  bRetVal = false;
+  bSearching = true;
+  for(u08Word = 0; (true == bSearching) && (u08Word < RTCOS_READY_WORDS_COUNT); ++u08Word)
+  {
+    u32Pending = atomic_load_explicit(&RTCOSi_stMain.tu32PendingMap[u08Word], memory_order_relaxed);
+    u32Skipped = 0;
+    while((true == bSearching) && (0 != (u32Pending & ~u32Skipped)))
+    {
+      u08TaskID = (uint8_t)((u08Word << 5) + _rtcos_clz(u32Pending & ~u32Skipped));
+      if(RTCOS_TASK_BAND(u08TaskID) > u08MaxBand)
+      {
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+        /* Pending bits follow the task IDs, a higher priority task may come after this one */
+        u32Skipped |= (0x80000000uL >> (u08TaskID & 31));
+#else
+        /* The highest priority pending task belongs to a lower band */
+        bSearching = false;
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+      }
+      else if(atomic_compare_exchange_weak_explicit(
+                &RTCOSi_stMain.tu32PendingMap[u08Word], &u32Pending,
+                u32Pending & ~(0x80000000uL >> (u08TaskID & 31)),
+                memory_order_acquire, memory_order_relaxed))
+      {
+        *pu08TaskID = u08TaskID;
+        bRetVal = true;
+        bSearching = false;
+      }
+    }
+  }
+  return bRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Queue a task that is not queued nor running yet. A worker queues it on its own
+  *             deque, any other thread or interrupt flags it in the pending bitmap.
+  * @param      u08TaskID ID of the ready task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_worker_schedule(uint8_t u08TaskID)
+{
+  uint8_t u08State;
+
+  u08State = RTCOS_TASK_STATE_IDLE;
+  /* Pairs with the fence of a worker that just finished the task and checks for new work */
+  atomic_thread_fence(memory_order_seq_cst);
+  if(atomic_compare_exchange_strong_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].u08State, &u08State,
+                                             RTCOS_TASK_STATE_QUEUED,
+                                             memory_order_seq_cst, memory_order_relaxed))
+  {
+    atomic_fetch_add_explicit(&RTCOSi_stMain.s32QueuedCount, 1, memory_order_seq_cst);
+    if(RTCOSi_s08WorkerID >= 0)
+    {
+      _rtcos_deque_push(&RTCOSi_stMain.tstWorkers[RTCOSi_s08WorkerID]
+                           .tstDeques[RTCOS_TASK_BAND(u08TaskID)], u08TaskID);
+    }
+    else
+    {
+      atomic_fetch_or_explicit(&RTCOSi_stMain.tu32PendingMap[u08TaskID >> 5],
+                               (uint32_t)(0x80000000uL >> (u08TaskID & 31)),
+                               memory_order_release);
+    }
+    if(0 != atomic_load_explicit(&RTCOSi_stMain.s32SleepersCount, memory_order_seq_cst))
+    {
+      pthread_mutex_lock(&RTCOSi_stMain.stSleepMutex);
+      pthread_cond_signal(&RTCOSi_stMain.stSleepCond);
+      pthread_mutex_unlock(&RTCOSi_stMain.stSleepMutex);
+    }
+    /* The first worker may be blocked in the idle handler */
+    RTCOS_PORT_WAKEUP();
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Mark a task as ready by queueing it on the workers
+  * @param      u08TaskID ID of the ready task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_set_task_ready(uint8_t u08TaskID)
+{
+  _rtcos_worker_schedule(u08TaskID);
+}
+
+/** ***********************************************************************************************
+  * @brief      Queue a task on the workers if it has pending events or messages
+  * @param      u08TaskID ID of the task to update
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_update_task_ready(uint8_t u08TaskID)
+{
+  if((0 != RTCOS_TASK_EVENTS_GET(u08TaskID))
+#ifdef RTCOS_ENABLE_MESSAGES
+    || (false == _rtcos_fifo_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+    || (false == _rtcos_ring_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+    )
+  {
+    _rtcos_worker_schedule(u08TaskID);
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Flag a task as ready from any context without masking interrupts
+  * @param      u08TaskID ID of the ready task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_post_task_ready(uint8_t u08TaskID)
+{
+  _rtcos_worker_schedule(u08TaskID);
+}
+
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+/** ***********************************************************************************************
+  * @brief      Give a priority level to a task, a task already queued on a worker keeps its
+  *             priority band until it runs
+  * @param      u08TaskID ID of the task
+  * @param      u08Priority New priority level, below RTCOS_PRIORITY_LEVELS_COUNT
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_move_task_priority(uint8_t u08TaskID, uint8_t u08Priority)
+{
+  RTCOS_TASK_PRIORITY(u08TaskID) = u08Priority;
+}
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+
+/** ***********************************************************************************************
+  * @brief      Find a task for a worker, band by band: its own deque first, then the tasks queued
+  *             from outside the workers, then the deques of the other workers
+  * @param      u08WorkerID Index of the calling worker
+  * @param      pu08TaskID This will hold the ID of the found task
+  * @return     true if a task is found, else false
+  ********************************************************************************************** */
+static bool _rtcos_worker_find_task(uint8_t u08WorkerID, uint8_t *pu08TaskID)
+{
+  uint8_t u08Band;
+  uint8_t u08Offset;
+  bool bRetVal;
+
+  bRetVal = false;
+  for(u08Band = 0; (false == bRetVal) && (u08Band < RTCOS_WORKER_PRIORITY_BANDS); ++u08Band)
+  {
+    bRetVal = _rtcos_deque_pop(&RTCOSi_stMain.tstWorkers[u08WorkerID].tstDeques[u08Band],
+                               pu08TaskID);
+    if(false == bRetVal)
+    {
+      bRetVal = _rtcos_claim_pending_task(u08Band, pu08TaskID);
+    }
+    for(u08Offset = 1; (false == bRetVal) && (u08Offset < RTCOS_WORKERS_COUNT); ++u08Offset)
+    {
+      bRetVal = _rtcos_deque_steal(&RTCOSi_stMain
+                                      .tstWorkers[(u08WorkerID + u08Offset) % RTCOS_WORKERS_COUNT]
+                                        .tstDeques[u08Band], pu08TaskID);
+    }
+  }
+  if(true == bRetVal)
+  {
+    atomic_fetch_sub_explicit(&RTCOSi_stMain.s32QueuedCount, 1, memory_order_relaxed);
+  }
+  return bRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Run a task taken by a worker. The task stays in the running state until its handler
+  *             returns so that no other worker can run it meanwhile.
+  * @param      u08TaskID ID of the task to run
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_worker_run_task(uint8_t u08TaskID)
+{
+  uint32_t u32UnhandledEvents;
+  uint32_t u32CurrentEvents;
+#if defined(RTCOS_ENABLE_STATS) || defined(RTCOS_ENABLE_TASK_BUDGETS)
+  uint32_t u32StartTime;
+#endif /* RTCOS_ENABLE_STATS || RTCOS_ENABLE_TASK_BUDGETS */
+
+  atomic_store_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].u08State, RTCOS_TASK_STATE_RUNNING,
+                        memory_order_relaxed);
+  RTCOSi_u08WorkerTaskID = u08TaskID;
+  u32CurrentEvents = RTCOS_TASK_EVENTS_TAKE(u08TaskID);
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+  _rtcos_event_counts_take(u08TaskID, u32CurrentEvents);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+  u32UnhandledEvents = 0;
+  if((0 != u32CurrentEvents)
+#ifdef RTCOS_ENABLE_MESSAGES
+     || (false == _rtcos_fifo_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+     || (false == _rtcos_ring_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+    )
+  {
+#if defined(RTCOS_ENABLE_STATS) || defined(RTCOS_ENABLE_TASK_BUDGETS)
+    u32StartTime = (uint32_t)RTCOS_PORT_TIMESTAMP();
+#endif /* RTCOS_ENABLE_STATS || RTCOS_ENABLE_TASK_BUDGETS */
+    RTCOS_TRACE(RTCOS_TRACE_DISPATCH_START, u08TaskID, u32CurrentEvents);
+    u32UnhandledEvents = (RTCOS_TASK_HANDLER(u08TaskID))
+                         (u32CurrentEvents,
+#ifdef RTCOS_ENABLE_MESSAGES
+                         _rtcos_fifo_count(u08TaskID),
+#else
+                         0,
+#endif /* RTCOS_ENABLE_MESSAGES */
+                         RTCOS_TASK_ARG(u08TaskID));
+    RTCOS_TRACE(RTCOS_TRACE_DISPATCH_END, u08TaskID, u32UnhandledEvents);
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+    _rtcos_budget_check(u08TaskID, u32CurrentEvents, u32StartTime);
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+#ifdef RTCOS_ENABLE_STATS
+    _rtcos_stats_record_run(u08TaskID, u32CurrentEvents, u32StartTime);
+#endif /* RTCOS_ENABLE_STATS */
+  }
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+  _rtcos_event_counts_restore(u08TaskID, u32UnhandledEvents);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+  if(0 != u32UnhandledEvents)
+  {
+    RTCOS_TASK_EVENTS_SET(u08TaskID, u32UnhandledEvents);
+  }
+  atomic_store_explicit(&RTCOSi_stMain.tstTasks[u08TaskID].u08State, RTCOS_TASK_STATE_IDLE,
+                        memory_order_seq_cst);
+  /* Work posted while the handler was running could not queue the task, queue it now */
+  atomic_thread_fence(memory_order_seq_cst);
+  _rtcos_update_task_ready(u08TaskID);
+}
+
+/** ***********************************************************************************************
+  * @brief      Block a worker until a task is queued
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_worker_sleep(void)
+{
+  pthread_mutex_lock(&RTCOSi_stMain.stSleepMutex);
+  atomic_fetch_add_explicit(&RTCOSi_stMain.s32SleepersCount, 1, memory_order_seq_cst);
+  while(atomic_load_explicit(&RTCOSi_stMain.s32QueuedCount, memory_order_seq_cst) <= 0)
+  {
+    pthread_cond_wait(&RTCOSi_stMain.stSleepCond, &RTCOSi_stMain.stSleepMutex);
+  }
+  atomic_fetch_sub_explicit(&RTCOSi_stMain.s32SleepersCount, 1, memory_order_seq_cst);
+  pthread_mutex_unlock(&RTCOSi_stMain.stSleepMutex);
+}
+
+/** ***********************************************************************************************
+  * @brief      Scheduling loop of a worker. The first worker calls the idle handler when it finds
+  *             nothing to run, the other ones spin for a while then sleep.
+  * @param      u08WorkerID Index of the calling worker
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_worker_loop(uint8_t u08WorkerID)
+{
+  uint8_t u08TaskID;
+  uint32_t u32Spins;
+  bool bFoundTask;
+#ifdef RTCOS_ENABLE_STATS
+  uint32_t u32PassTime;
+
+  u32PassTime = (uint32_t)RTCOS_PORT_TIMESTAMP();
+#endif /* RTCOS_ENABLE_STATS */
+  RTCOSi_s08WorkerID = (int8_t)u08WorkerID;
+  u08TaskID = 0;
+  u32Spins = 0;
+  while(1)
+  {
+    bFoundTask = _rtcos_worker_find_task(u08WorkerID, &u08TaskID);
+    if(true == bFoundTask)
+    {
+      _rtcos_worker_run_task(u08TaskID);
+      u32Spins = 0;
+    }
+    else if((0 == u08WorkerID) && (NULL != RTCOSi_stMain.pfIdleHandler))
+    {
+#ifdef RTCOS_ENABLE_TICKLESS
+      RTCOS_PORT_SET_WAKEUP(rtcos_get_ticks_to_next_deadline());
+#endif /* RTCOS_ENABLE_TICKLESS */
+      RTCOS_TRACE(RTCOS_TRACE_IDLE_ENTER, RTCOS_TRACE_NO_TASK, 0);
+      (RTCOSi_stMain.pfIdleHandler)();
+      RTCOS_TRACE(RTCOS_TRACE_IDLE_EXIT, RTCOS_TRACE_NO_TASK, 0);
+    }
+    else if(++u32Spins < RTCOS_WORKER_SPIN_COUNT)
+    {
+      sched_yield();
+    }
+    else
+    {
+      _rtcos_worker_sleep();
+      u32Spins = 0;
+    }
+#ifdef RTCOS_ENABLE_STATS
+    _rtcos_stats_record_pass(u08WorkerID, bFoundTask, &u32PassTime);
+#endif /* RTCOS_ENABLE_STATS */
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Entry point of the worker threads started by rtcos_run()
+  * @param      pvArg Index of the worker
+  * @return     Never returns
+  ********************************************************************************************** */
+static void *_rtcos_worker_thread(void *pvArg)
+{
+#ifdef RTCOS_ENABLE_INSTANCES
+  /* The worker is given its own slot so that it can find the instance that started it */
+  RTCOSi_pstMain = ((rtcos_worker_t *)pvArg)->pstMain;
+  _rtcos_worker_loop((uint8_t)((rtcos_worker_t *)pvArg - RTCOSi_stMain.tstWorkers));
+#else
+  _rtcos_worker_loop((uint8_t)(uintptr_t)pvArg);
+#endif /* RTCOS_ENABLE_INSTANCES */
+  return NULL;
+}
+#else
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+/** ***********************************************************************************************
+  * @brief      Give a deadline to the pending work of a task, a task keeps the earliest deadline
+  *             of its pending work, must be called inside a critical section
+  * @param      u08TaskID ID of the task receiving work
+  * @param      u32Deadline Absolute deadline in ticks
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_edf_post_deadline(uint8_t u08TaskID, uint32_t u32Deadline)
+{
+  if((0 == (RTCOSi_stMain.tu32DeadlineMap[u08TaskID >> 5] & (0x80000000uL >> (u08TaskID & 31)))) ||
+     RTCOS_DEADLINE_BEFORE(u32Deadline, RTCOSi_stMain.tstTasks[u08TaskID].u32Deadline))
+  {
+    RTCOSi_stMain.tstTasks[u08TaskID].u32Deadline = u32Deadline;
+    RTCOSi_stMain.tu32DeadlineMap[u08TaskID >> 5] |= (0x80000000uL >> (u08TaskID & 31));
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Find the task having the earliest deadline, tasks get a deadline only when they
+  *             are ready, must be called inside a critical section
+  * @param      pu08ReadyTaskID This will hold the ID of the found task
+  * @return     true if a task has a deadline, else false
+  ********************************************************************************************** */
+static bool _rtcos_edf_find_task(uint8_t *pu08ReadyTaskID)
+{
+  uint32_t u32Pending;
+  uint32_t u32Earliest;
+  uint8_t u08Word;
+  uint8_t u08TaskID;
+  bool bRetVal;
+
+  bRetVal = false;
+  u32Earliest = 0;
+  for(u08Word = 0; u08Word < RTCOS_READY_WORDS_COUNT; ++u08Word)
+  {
+    u32Pending = RTCOSi_stMain.tu32DeadlineMap[u08Word];
+    while(0 != u32Pending)
+    {
+      u08TaskID = (uint8_t)((u08Word << 5) + _rtcos_clz(u32Pending));
+      u32Pending &= ~(0x80000000uL >> (u08TaskID & 31));
+      /* Equal deadlines keep the lowest task ID */
+      if((false == bRetVal) ||
+         RTCOS_DEADLINE_BEFORE(RTCOSi_stMain.tstTasks[u08TaskID].u32Deadline, u32Earliest))
+      {
+        u32Earliest = RTCOSi_stMain.tstTasks[u08TaskID].u32Deadline;
+        *pu08ReadyTaskID = u08TaskID;
+        bRetVal = true;
+      }
+    }
+  }
+  return bRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Hand the pending deadline of a task over to the handler call about to run,
+  *             work reaching the task from now on gets a new deadline,
+  *             must be called inside a critical section
+  * @param      u08TaskID ID of the dispatched task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_edf_dispatch(uint8_t u08TaskID)
+{
+  RTCOSi_stMain.tstTasks[u08TaskID].bRunHasDeadline =
+    (0 != (RTCOSi_stMain.tu32DeadlineMap[u08TaskID >> 5] & (0x80000000uL >> (u08TaskID & 31))));
+  RTCOSi_stMain.tstTasks[u08TaskID].u32RunDeadline = RTCOSi_stMain.tstTasks[u08TaskID].u32Deadline;
+  RTCOSi_stMain.tu32DeadlineMap[u08TaskID >> 5] &= ~(0x80000000uL >> (u08TaskID & 31));
+}
+
+/** ***********************************************************************************************
+  * @brief      Count a deadline miss if the handler call of a task ended after its deadline tick,
+  *             must be called inside a critical section
+  * @param      u08TaskID ID of the task whose handler returned
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_edf_complete(uint8_t u08TaskID)
+{
+  if((true == RTCOSi_stMain.tstTasks[u08TaskID].bRunHasDeadline) &&
+     RTCOS_DEADLINE_BEFORE(RTCOSi_stMain.tstTasks[u08TaskID].u32RunDeadline,
+                           RTCOSi_stMain.u32SysTicksCount))
+  {
+    ++RTCOSi_stMain.tstTasks[u08TaskID].u32DeadlineMisses;
+  }
+  RTCOSi_stMain.tstTasks[u08TaskID].bRunHasDeadline = false;
+}
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+/** ***********************************************************************************************
+  * @brief      Add a ready task to the tasks of its priority level,
+  *             must be called inside a critical section
+  * @param      u08TaskID ID of the ready task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_level_add_task(uint8_t u08TaskID)
+{
+  uint8_t u08Level;
+
+  u08Level = RTCOS_TASK_PRIORITY(u08TaskID);
+  RTCOSi_stMain.tu32LevelTasks[u08Level][u08TaskID >> 5] |= (0x80000000uL >> (u08TaskID & 31));
+  RTCOSi_stMain.u32LevelMap |= (0x80000000uL >> u08Level);
+}
+
+/** ***********************************************************************************************
+  * @brief      Remove a task from the tasks of its priority level, the level bit is cleared with
+  *             its last ready task, must be called inside a critical section
+  * @param      u08TaskID ID of the task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_level_remove_task(uint8_t u08TaskID)
+{
+  uint8_t u08Level;
+  uint8_t u08Word;
+  uint32_t u32Ready;
+
+  u08Level = RTCOS_TASK_PRIORITY(u08TaskID);
+  RTCOSi_stMain.tu32LevelTasks[u08Level][u08TaskID >> 5] &= ~(0x80000000uL >> (u08TaskID & 31));
+  u32Ready = 0;
+  for(u08Word = 0; u08Word < RTCOS_READY_WORDS_COUNT; ++u08Word)
+  {
+    u32Ready |= RTCOSi_stMain.tu32LevelTasks[u08Level][u08Word];
+  }
+  if(0 == u32Ready)
+  {
+    RTCOSi_stMain.u32LevelMap &= ~(0x80000000uL >> u08Level);
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Give a priority level to a task, a ready task moves to the ready tasks of its new
+  *             level and keeps its place in the ready bitmap, must be called inside a critical
+  *             section
+  * @param      u08TaskID ID of the task
+  * @param      u08Priority New priority level, below RTCOS_PRIORITY_LEVELS_COUNT
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_move_task_priority(uint8_t u08TaskID, uint8_t u08Priority)
+{
+  bool bTaskReady;
+
+  bTaskReady = (0 != (RTCOSi_stMain.stReadyMap.tu32Map[u08TaskID >> 5] &
+                      (0x80000000uL >> (u08TaskID & 31))));
+  if(true == bTaskReady)
+  {
+    _rtcos_level_remove_task(u08TaskID);
+  }
+  RTCOS_TASK_PRIORITY(u08TaskID) = u08Priority;
+  if(true == bTaskReady)
+  {
+    _rtcos_level_add_task(u08TaskID);
+  }
+}
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+
+/** ***********************************************************************************************
+  * @brief      Set the bit of a task in the ready bitmap without waking the system up,
+  *             must be called inside a critical section
+  * @param      u08TaskID ID of the ready task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_mark_task_ready(uint8_t u08TaskID)
+{
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+  /* The wait of a task starts when it becomes ready */
+  if(0 == (RTCOSi_stMain.stReadyMap.tu32Map[u08TaskID >> 5] & (0x80000000uL >> (u08TaskID & 31))))
+  {
+    RTCOSi_stMain.tstTasks[u08TaskID].u32ReadySince = RTCOSi_stMain.u32SysTicksCount;
+  }
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+  /* Work reaching a task with no deadline pending is due its relative deadline from now */
+  if((0 != RTCOSi_stMain.tstTasks[u08TaskID].u32RelativeDeadline) &&
+     (0 == (RTCOSi_stMain.tu32DeadlineMap[u08TaskID >> 5] & (0x80000000uL >> (u08TaskID & 31)))))
+  {
+    _rtcos_edf_post_deadline(u08TaskID, RTCOSi_stMain.u32SysTicksCount +
+                                        RTCOSi_stMain.tstTasks[u08TaskID].u32RelativeDeadline);
+  }
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+  RTCOSi_stMain.stReadyMap.tu32Map[u08TaskID >> 5] |= (0x80000000uL >> (u08TaskID & 31));
+#if (RTCOS_READY_WORDS_COUNT > 1)
+  RTCOSi_stMain.stReadyMap.u32GroupMap |= (0x80000000uL >> (u08TaskID >> 5));
+#endif /* RTCOS_READY_WORDS_COUNT */
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+  _rtcos_level_add_task(u08TaskID);
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+}
+
+/** ***********************************************************************************************
+  * @brief      Mark a task as ready in the ready bitmap, must be called inside a critical section
+  * @param      u08TaskID ID of the ready task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_set_task_ready(uint8_t u08TaskID)
+{
+  _rtcos_mark_task_ready(u08TaskID);
+  RTCOS_PORT_WAKEUP();
+}
+
+/** ***********************************************************************************************
+  * @brief      Remove a task from the ready bitmap, must be called inside a critical section
+  * @param      u08TaskID ID of the task that has nothing left to handle
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_clear_task_ready(uint8_t u08TaskID)
+{
+  RTCOSi_stMain.stReadyMap.tu32Map[u08TaskID >> 5] &= ~(0x80000000uL >> (u08TaskID & 31));
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+  RTCOSi_stMain.tu32AgedMap[u08TaskID >> 5] &= ~(0x80000000uL >> (u08TaskID & 31));
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#if (RTCOS_READY_WORDS_COUNT > 1)
+  if(0 == RTCOSi_stMain.stReadyMap.tu32Map[u08TaskID >> 5])
+  {
+    RTCOSi_stMain.stReadyMap.u32GroupMap &= ~(0x80000000uL >> (u08TaskID >> 5));
+  }
+#endif /* RTCOS_READY_WORDS_COUNT */
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+  _rtcos_level_remove_task(u08TaskID);
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+}
+
+/** ***********************************************************************************************
+  * @brief      Set or clear the ready bit of a task depending on its pending events and messages,
+  *             must be called inside a critical section
+  * @param      u08TaskID ID of the task to update
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_update_task_ready(uint8_t u08TaskID)
+{
+  if((0 != RTCOS_TASK_EVENTS_GET(u08TaskID))
+#ifdef RTCOS_ENABLE_MESSAGES
+    || (false == _rtcos_fifo_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+    || (false == _rtcos_ring_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+    )
+  {
+    _rtcos_set_task_ready(u08TaskID);
+  }
+  else
+  {
+    _rtcos_clear_task_ready(u08TaskID);
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+    RTCOSi_stMain.tu32DeadlineMap[u08TaskID >> 5] &= ~(0x80000000uL >> (u08TaskID & 31));
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+  }
+}
+
+#ifdef RTCOS_ENABLE_PENDING_READY_MAP
+/** ***********************************************************************************************
+  * @brief      Flag a task as ready from any context without masking interrupts,
+  *             the scheduler moves the flag to the ready bitmap on its next pass
+  * @param      u08TaskID ID of the ready task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_post_task_ready(uint8_t u08TaskID)
+{
+  atomic_fetch_or_explicit(&RTCOSi_stMain.tu32PendingMap[u08TaskID >> 5],
+                           (uint32_t)(0x80000000uL >> (u08TaskID & 31)),
+                           memory_order_release);
+  RTCOS_PORT_WAKEUP();
+}
+
+/** ***********************************************************************************************
+  * @brief      Move the tasks flagged by _rtcos_post_task_ready() to the ready bitmap,
+  *             must be called inside a critical section
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_collect_pending_ready(void)
+{
+  uint8_t u08Word;
+  uint32_t u32Pending;
+#if defined(RTCOS_ENABLE_TASK_PRIORITIES) || defined(RTCOS_ENABLE_FAIR_SCHEDULING) || \
+    defined(RTCOS_ENABLE_EDF_SCHEDULING)
+  uint8_t u08TaskID;
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES || RTCOS_ENABLE_FAIR_SCHEDULING ||
+          RTCOS_ENABLE_EDF_SCHEDULING */
+
+  for(u08Word = 0; u08Word < RTCOS_READY_WORDS_COUNT; ++u08Word)
+  {
+    if(0 != atomic_load_explicit(&RTCOSi_stMain.tu32PendingMap[u08Word], memory_order_relaxed))
+    {
+      u32Pending = atomic_exchange_explicit(&RTCOSi_stMain.tu32PendingMap[u08Word], 0,
+                                            memory_order_acquire);
+#if defined(RTCOS_ENABLE_TASK_PRIORITIES) || defined(RTCOS_ENABLE_FAIR_SCHEDULING) || \
+    defined(RTCOS_ENABLE_EDF_SCHEDULING)
+      /* Each task also joins its priority level and starts its wait or deadline */
+      while(0 != u32Pending)
+      {
+        u08TaskID = (uint8_t)((u08Word << 5) + _rtcos_clz(u32Pending));
+        u32Pending &= ~(0x80000000uL >> (u08TaskID & 31));
+        _rtcos_mark_task_ready(u08TaskID);
+      }
+#else
+      RTCOSi_stMain.stReadyMap.tu32Map[u08Word] |= u32Pending;
+#if (RTCOS_READY_WORDS_COUNT > 1)
+      RTCOSi_stMain.stReadyMap.u32GroupMap |= (0x80000000uL >> u08Word);
+#endif /* RTCOS_READY_WORDS_COUNT */
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES || RTCOS_ENABLE_FAIR_SCHEDULING ||
+          RTCOS_ENABLE_EDF_SCHEDULING */
+    }
+  }
+}
+#endif /* RTCOS_ENABLE_PENDING_READY_MAP */
+
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+/** ***********************************************************************************************
+  * @brief      Pick the ready task of a level that comes after the last one dispatched at this
+  *             level, wrapping around to the lowest ID, must be called inside a critical section
+  * @param      u08Level Priority level having at least one ready task
+  * @return     ID of the task to dispatch
+  ********************************************************************************************** */
+static uint8_t _rtcos_round_robin_task(uint8_t u08Level)
+{
+  uint32_t u32Ready;
+  uint8_t u08Last;
+  uint8_t u08Word;
+  uint8_t u08Count;
+
+  u08Last = RTCOSi_stMain.tu08LastTask[u08Level];
+  u08Word = (uint8_t)(u08Last >> 5);
+  u32Ready = RTCOSi_stMain.tu32LevelTasks[u08Level][u08Word] & (0x7FFFFFFFuL >> (u08Last & 31));
+  for(u08Count = 0; (0 == u32Ready) && (u08Count < RTCOS_READY_WORDS_COUNT); ++u08Count)
+  {
+    u08Word = (uint8_t)((u08Word + 1) % RTCOS_READY_WORDS_COUNT);
+    u32Ready = RTCOSi_stMain.tu32LevelTasks[u08Level][u08Word];
+  }
+  return (uint8_t)((u08Word << 5) + _rtcos_clz(u32Ready));
+}
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+
+/** ***********************************************************************************************
+  * @brief      Boost the tasks that have been ready for RTCOS_AGING_TICKS ticks or more, the scan
+  *             is done once per tick, must be called inside a critical section
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_age_ready_tasks(void)
+{
+#if (RTCOS_AGING_TICKS > 0)
+  uint32_t u32Ready;
+  uint8_t u08Word;
+  uint8_t u08TaskID;
+
+  if(RTCOSi_stMain.u32AgingTick != RTCOSi_stMain.u32SysTicksCount)
+  {
+    RTCOSi_stMain.u32AgingTick = RTCOSi_stMain.u32SysTicksCount;
+    for(u08Word = 0; u08Word < RTCOS_READY_WORDS_COUNT; ++u08Word)
+    {
+      u32Ready = RTCOSi_stMain.stReadyMap.tu32Map[u08Word];
+      while(0 != u32Ready)
+      {
+        u08TaskID = (uint8_t)((u08Word << 5) + _rtcos_clz(u32Ready));
+        u32Ready &= ~(0x80000000uL >> (u08TaskID & 31));
+        if((RTCOSi_stMain.u32SysTicksCount - RTCOSi_stMain.tstTasks[u08TaskID].u32ReadySince) >=
+           RTCOS_AGING_TICKS)
+        {
+          RTCOSi_stMain.tu32AgedMap[u08TaskID >> 5] |= (0x80000000uL >> (u08TaskID & 31));
+        }
+      }
+    }
+  }
+#endif /* RTCOS_AGING_TICKS */
+}
+
+/** ***********************************************************************************************
+  * @brief      Find the boosted task that has been ready for the longest time, equal waits keep
+  *             the lowest task ID, must be called inside a critical section
+  * @param      pu08ReadyTaskID This will hold the ID of the found task
+  * @return     true if a task is boosted, else false
+  ********************************************************************************************** */
+static bool _rtcos_find_aged_task(uint8_t *pu08ReadyTaskID)
+{
+  uint32_t u32Aged;
+  uint32_t u32Wait;
+  uint32_t u32LongestWait;
+  uint8_t u08Word;
+  uint8_t u08TaskID;
+  bool bRetVal;
+
+  bRetVal = false;
+  u32LongestWait = 0;
+  for(u08Word = 0; u08Word < RTCOS_READY_WORDS_COUNT; ++u08Word)
+  {
+    u32Aged = RTCOSi_stMain.tu32AgedMap[u08Word];
+    while(0 != u32Aged)
+    {
+      u08TaskID = (uint8_t)((u08Word << 5) + _rtcos_clz(u32Aged));
+      u32Aged &= ~(0x80000000uL >> (u08TaskID & 31));
+      u32Wait = RTCOSi_stMain.u32SysTicksCount - RTCOSi_stMain.tstTasks[u08TaskID].u32ReadySince;
+      if((false == bRetVal) || (u32Wait > u32LongestWait))
+      {
+        u32LongestWait = u32Wait;
+        *pu08ReadyTaskID = u08TaskID;
+        bRetVal = true;
+      }
+    }
+  }
+  return bRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Account for the dispatch of a task: record its wait, drop its boost and give the
+  *             next turn of its level to the task after it, must be called inside a critical
+  *             section
+  * @param      u08TaskID ID of the dispatched task
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_fair_dispatch(uint8_t u08TaskID)
+{
+  uint32_t u32Wait;
+
+  u32Wait = RTCOSi_stMain.u32SysTicksCount - RTCOSi_stMain.tstTasks[u08TaskID].u32ReadySince;
+  if(u32Wait > RTCOSi_stMain.tstTasks[u08TaskID].u32MaxWaitTicks)
+  {
+    RTCOSi_stMain.tstTasks[u08TaskID].u32MaxWaitTicks = u32Wait;
+  }
+  RTCOSi_stMain.tstTasks[u08TaskID].u32ReadySince = RTCOSi_stMain.u32SysTicksCount;
+  RTCOSi_stMain.tu32AgedMap[u08TaskID >> 5] &= ~(0x80000000uL >> (u08TaskID & 31));
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+  RTCOSi_stMain.tu08LastTask[RTCOS_TASK_PRIORITY(u08TaskID)] = u08TaskID;
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+}
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+
+/** ***********************************************************************************************
+  * @brief      Find the highest priority task with an event or a message,
+  *             this is a constant time lookup in the ready bitmap indexed by priority level
+  * @param      pu08ReadyTaskID This will hold the ID of the found ready task
+  * @return     true if a task is found, else false
+  ********************************************************************************************** */
+static bool _rtcos_find_ready_task(uint8_t *pu08ReadyTaskID)
+{
+#if !defined(RTCOS_ENABLE_TASK_PRIORITIES) || !defined(RTCOS_ENABLE_FAIR_SCHEDULING)
+  uint8_t u08Word;
+#endif /* !RTCOS_ENABLE_TASK_PRIORITIES || !RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+  uint8_t u08Level;
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+  bool bRetVal;
+
+  bRetVal = false;
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+  /* Boosted tasks go first */
+  bRetVal = _rtcos_find_aged_task(pu08ReadyTaskID);
+  if((false == bRetVal) && pu08ReadyTaskID)
+#elif defined(RTCOS_ENABLE_EDF_SCHEDULING)
+  /* The earliest deadline goes first, tasks without a deadline follow in priority order */
+  bRetVal = _rtcos_edf_find_task(pu08ReadyTaskID);
+  if((false == bRetVal) && pu08ReadyTaskID)
+#else
+  if(pu08ReadyTaskID)
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+  {
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+    /* Highest ready level first, then the lowest task ID of that level or its next turn */
+    if(0 != RTCOSi_stMain.u32LevelMap)
+    {
+      u08Level = _rtcos_clz(RTCOSi_stMain.u32LevelMap);
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+      *pu08ReadyTaskID = _rtcos_round_robin_task(u08Level);
+#else
+      u08Word = 0;
+      while(0 == RTCOSi_stMain.tu32LevelTasks[u08Level][u08Word])
+      {
+        ++u08Word;
+      }
+      *pu08ReadyTaskID = (uint8_t)((u08Word << 5) +
+                                   _rtcos_clz(RTCOSi_stMain.tu32LevelTasks[u08Level][u08Word]));
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+      bRetVal = true;
+    }
+#else
+#if (RTCOS_READY_WORDS_COUNT > 1)
+    if(0 != RTCOSi_stMain.stReadyMap.u32GroupMap)
+    {
+      u08Word = _rtcos_clz(RTCOSi_stMain.stReadyMap.u32GroupMap);
+#else
+    u08Word = 0;
+    if(0 != RTCOSi_stMain.stReadyMap.tu32Map[0])
+    {
+#endif /* RTCOS_READY_WORDS_COUNT */
+      *pu08ReadyTaskID =
+        (uint8_t)((u08Word << 5) + _rtcos_clz(RTCOSi_stMain.stReadyMap.tu32Map[u08Word]));
+      bRetVal = true;
+    }
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+  }
+  return bRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Run the task that has the highest priority and is ready
+  * @param      u08TaskID ID of the task to run
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_run_ready_task(uint8_t u08TaskID)
+{
+  uint32_t u32UnhandledEvents;
+  uint32_t u32CurrentEvents;
+#if defined(RTCOS_ENABLE_STATS) || defined(RTCOS_ENABLE_TASK_BUDGETS)
+  uint32_t u32StartTime;
+#endif /* RTCOS_ENABLE_STATS || RTCOS_ENABLE_TASK_BUDGETS */
+
+  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
+  {
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+    RTCOSi_stMain.u08CurrentTaskID = u08TaskID;
+    u32CurrentEvents = RTCOS_TASK_EVENTS_TAKE(u08TaskID);
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+    _rtcos_event_counts_take(u08TaskID, u32CurrentEvents);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+#else
+    RTCOS_ENTER_CRITICAL_SECTION();
+    RTCOSi_stMain.u08CurrentTaskID = u08TaskID;
+    u32CurrentEvents = RTCOSi_stMain.tstTasks[RTCOSi_stMain.u08CurrentTaskID].u32EventFlags;
+    RTCOSi_stMain.tstTasks[RTCOSi_stMain.u08CurrentTaskID].u32EventFlags = 0;
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+    _rtcos_event_counts_take(u08TaskID, u32CurrentEvents);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+    RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+    u32UnhandledEvents = 0;
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+    /* The events that made the task ready may have been cleared from an ISR meanwhile */
+    if((0 != u32CurrentEvents)
+#ifdef RTCOS_ENABLE_MESSAGES
+       || (false == _rtcos_fifo_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+       || (false == _rtcos_ring_empty(u08TaskID))
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+      )
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+    {
+#if defined(RTCOS_ENABLE_STATS) || defined(RTCOS_ENABLE_TASK_BUDGETS)
+      u32StartTime = (uint32_t)RTCOS_PORT_TIMESTAMP();
+#endif /* RTCOS_ENABLE_STATS || RTCOS_ENABLE_TASK_BUDGETS */
+      RTCOS_TRACE(RTCOS_TRACE_DISPATCH_START, RTCOSi_stMain.u08CurrentTaskID, u32CurrentEvents);
+      u32UnhandledEvents = (RTCOS_TASK_HANDLER(RTCOSi_stMain.u08CurrentTaskID))
+                           (u32CurrentEvents,
+#ifdef RTCOS_ENABLE_MESSAGES
+                           _rtcos_fifo_count(RTCOSi_stMain.u08CurrentTaskID),
+#else
+                           0,
+#endif /* RTCOS_ENABLE_MESSAGES */
+                           RTCOS_TASK_ARG(RTCOSi_stMain.u08CurrentTaskID));
+      RTCOS_TRACE(RTCOS_TRACE_DISPATCH_END, RTCOSi_stMain.u08CurrentTaskID, u32UnhandledEvents);
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+      _rtcos_budget_check(RTCOSi_stMain.u08CurrentTaskID, u32CurrentEvents, u32StartTime);
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+#ifdef RTCOS_ENABLE_STATS
+      _rtcos_stats_record_run(RTCOSi_stMain.u08CurrentTaskID, u32CurrentEvents, u32StartTime);
+#endif /* RTCOS_ENABLE_STATS */
+    }
+    RTCOS_ENTER_CRITICAL_SECTION();
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+    _rtcos_event_counts_restore(RTCOSi_stMain.u08CurrentTaskID, u32UnhandledEvents);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+    RTCOS_TASK_EVENTS_SET(RTCOSi_stMain.u08CurrentTaskID, u32UnhandledEvents);
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+    _rtcos_edf_complete(RTCOSi_stMain.u08CurrentTaskID);
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+    /* The ready bit is left untouched while the handler runs and is only refreshed here */
+    _rtcos_update_task_ready(RTCOSi_stMain.u08CurrentTaskID);
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+}
+#endif /* RTCOS_ENABLE_WORKERS */
+
+/** ***********************************************************************************************
+  * @brief      Unlink a used event from the list of its task and give it back to the free list,
+  *             must be called inside a critical section
+  * @param      u16EventIdx Index of the event to release
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_release_future_event(uint16_t u16EventIdx)
+{
+  rtcos_future_event_t *pstEvent;
+
+  pstEvent = &RTCOSi_stMain.tstFutureEvents[u16EventIdx];
+  if(RTCOS_FUTURE_EVENT_NONE == pstEvent->u16Prev)
+  {
+    RTCOSi_stMain.tstTasks[pstEvent->u08TaskID].u16FutureEvents = pstEvent->u16Next;
+  }
+  else
+  {
+    RTCOSi_stMain.tstFutureEvents[pstEvent->u16Prev].u16Next = pstEvent->u16Next;
+  }
+  if(RTCOS_FUTURE_EVENT_NONE != pstEvent->u16Next)
+  {
+    RTCOSi_stMain.tstFutureEvents[pstEvent->u16Next].u16Prev = pstEvent->u16Prev;
+  }
+  pstEvent->bInUse = false;
+  pstEvent->u16Next = RTCOSi_stMain.u16FreeFutureEvents;
+  RTCOSi_stMain.u16FreeFutureEvents = u16EventIdx;
+}
+
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+/** ***********************************************************************************************
+  * @brief      Link a node in the wheel slot matching its expiry tick.
+  *             The level is chosen from the distance to the last processed tick, delays longer
+  *             than the wheel range are parked in the last level and re-inserted when cascaded.
+  * @param      pstNode Node to insert, its expiry tick must be after the last processed tick
+  *             unless the wheel is being processed
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_wheel_insert(rtcos_wheel_node_t *pstNode)
+{
+  uint32_t u32Expiry;
+  uint32_t u32Delta;
+  uint8_t u08Level;
+  rtcos_wheel_node_t **ppstSlot;
+
+  u32Expiry = pstNode->u32ExpiryTick;
+  u32Delta = u32Expiry - RTCOSi_stMain.u32WheelTick;
+  if(u32Delta >= RTCOS_WHEEL_RANGE)
+  {
+    u32Delta = RTCOS_WHEEL_RANGE - 1;
+    u32Expiry = RTCOSi_stMain.u32WheelTick + u32Delta;
+  }
+  u08Level = 0;
+  while((u08Level < (RTCOS_TIMING_WHEEL_LEVELS - 1)) &&
+        (u32Delta >= (1uL << (RTCOS_TIMING_WHEEL_SLOT_BITS * (u08Level + 1)))))
+  {
+    ++u08Level;
+  }
+  ppstSlot = &RTCOSi_stMain
+               .tpstWheel[u08Level][(u32Expiry >> (RTCOS_TIMING_WHEEL_SLOT_BITS * u08Level)) &
+                                    RTCOS_WHEEL_SLOT_MASK];
+  pstNode->pstNext = *ppstSlot;
+  if(pstNode->pstNext)
+  {
+    pstNode->pstNext->ppstPrev = &pstNode->pstNext;
+  }
+  pstNode->ppstPrev = ppstSlot;
+  pstNode->u08Level = u08Level;
+  *ppstSlot = pstNode;
+  ++RTCOSi_stMain.tu16WheelLevelCount[u08Level];
+}
+
+/** ***********************************************************************************************
+  * @brief      Unlink a node from the wheel, does nothing if the node is not linked
+  * @param      pstNode Node to remove
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_wheel_remove(rtcos_wheel_node_t *pstNode)
+{
+  if(pstNode->ppstPrev)
+  {
+    *pstNode->ppstPrev = pstNode->pstNext;
+    if(pstNode->pstNext)
+    {
+      pstNode->pstNext->ppstPrev = pstNode->ppstPrev;
+    }
+    pstNode->pstNext = NULL;
+    pstNode->ppstPrev = NULL;
+    --RTCOSi_stMain.tu16WheelLevelCount[pstNode->u08Level];
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Move the content of a slot to a local list head so that nodes can still be removed
+  *             while the list is being walked
+  * @param      ppstSlot Slot to empty
+  * @param      ppstList Head of the local list receiving the nodes
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_wheel_detach(rtcos_wheel_node_t **ppstSlot, rtcos_wheel_node_t **ppstList)
+{
+  *ppstList = *ppstSlot;
+  *ppstSlot = NULL;
+  if(*ppstList)
+  {
+    (*ppstList)->ppstPrev = ppstList;
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Handle an expired future event: post its flags and reload it if it is periodic
+  * @param      pstEvent Expired future event
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_wheel_expire_event(rtcos_future_event_t *pstEvent)
+{
+  if(RTCOSi_stMain.u16FutureEventsCount > 0)
+  {
+    RTCOSi_stMain.u16FutureEventsCount--;
+  }
+  RTCOS_EVENT_COUNTS_POST(pstEvent->u08TaskID, pstEvent->u32EventFlags);
+  RTCOS_TASK_EVENTS_SET(pstEvent->u08TaskID, pstEvent->u32EventFlags);
+  RTCOS_TRACE(RTCOS_TRACE_EVENT_POST, pstEvent->u08TaskID, pstEvent->u32EventFlags);
+  _rtcos_set_task_ready(pstEvent->u08TaskID);
+  if(0 == pstEvent->u32ReloadDelay)
+  {
+    _rtcos_release_future_event((uint16_t)(pstEvent - RTCOSi_stMain.tstFutureEvents));
+  }
+  else
+  {
+    pstEvent->stNode.u32ExpiryTick += pstEvent->u32ReloadDelay;
+    _rtcos_wheel_insert(&pstEvent->stNode);
+  }
+}
+
+#ifdef RTCOS_ENABLE_TIMERS
+/** ***********************************************************************************************
+  * @brief      Handle an expired timer: re-arm it if periodic then call its callback
+  * @param      pstTimer Expired timer
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_wheel_expire_timer(rtcos_timer_t *pstTimer)
+{
+  pstTimer->u32StartTickCount = RTCOS_EXPIRY_TICKS_COUNT;
+  RTCOS_TIMER_CLEAR_START_DELAY(pstTimer);
+  if(RTCOS_TIMER_ONE_SHOT == pstTimer->ePeriodType)
+  {
+    pstTimer->bInUse = false;
+  }
+  else
+  {
+    pstTimer->stNode.u32ExpiryTick = RTCOSi_stMain.u32WheelTick + pstTimer->u32TickDelay + 1;
+    _rtcos_wheel_insert(&pstTimer->stNode);
+  }
+  if(pstTimer->pfTimerCb)
+  {
+    RTCOS_TRACE(RTCOS_TRACE_TIMER_START, RTCOS_TRACE_NO_TASK, pstTimer - RTCOSi_stMain.tstTimers);
+    RTCOS_TIMER_CB_PROLOGUE();
+    pstTimer->pfTimerCb(pstTimer->pvArg);
+    RTCOS_TIMER_CB_EPILOGUE();
+    RTCOS_TRACE(RTCOS_TRACE_TIMER_END, RTCOS_TRACE_NO_TASK, pstTimer - RTCOSi_stMain.tstTimers);
+  }
+}
+#endif /* RTCOS_ENABLE_TIMERS */
+
+/** ***********************************************************************************************
+  * @brief      Advance the wheel by one tick: cascade the upper levels when the lower one wraps,
+  *             then expire every node of the current slot.
+  *             The cost is independent from the number of scheduled nodes.
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_wheel_process_tick(void)
+{
+  rtcos_wheel_node_t *pstList;
+  rtcos_wheel_node_t *pstNode;
+  uint32_t u32Slot;
+  uint8_t u08Level;
+
+  ++RTCOSi_stMain.u32WheelTick;
+  u32Slot = RTCOSi_stMain.u32WheelTick & RTCOS_WHEEL_SLOT_MASK;
+  for(u08Level = 1; (0 == u32Slot) && (u08Level < RTCOS_TIMING_WHEEL_LEVELS); ++u08Level)
+  {
+    u32Slot = (RTCOSi_stMain.u32WheelTick >> (RTCOS_TIMING_WHEEL_SLOT_BITS * u08Level)) &
+              RTCOS_WHEEL_SLOT_MASK;
+    _rtcos_wheel_detach(&RTCOSi_stMain.tpstWheel[u08Level][u32Slot], &pstList);
+    while(pstList)
+    {
+      pstNode = pstList;
+      _rtcos_wheel_remove(pstNode);
+      _rtcos_wheel_insert(pstNode);
+    }
+  }
+  _rtcos_wheel_detach(&RTCOSi_stMain
+                         .tpstWheel[0][RTCOSi_stMain.u32WheelTick & RTCOS_WHEEL_SLOT_MASK],
+                      &pstList);
+  while(pstList)
+  {
+    pstNode = pstList;
+    _rtcos_wheel_remove(pstNode);
+#ifdef RTCOS_ENABLE_TIMERS
+    if(RTCOS_WHEEL_NODE_TIMER == pstNode->u08Kind)
+    {
+      _rtcos_wheel_expire_timer((rtcos_timer_t *)pstNode);
+    }
+    else
+#endif /* RTCOS_ENABLE_TIMERS */
+    {
+      _rtcos_wheel_expire_event((rtcos_future_event_t *)pstNode);
+    }
+  }
+}
+
+#ifdef RTCOS_ENABLE_TICKLESS
+/** ***********************************************************************************************
+  * @brief      Get the number of ticks until the earliest node of the wheel expires.
+  *             A node whose delay exceeded the wheel range is parked in a slot that comes before
+  *             its expiry, possibly before the slot of a sooner node, so every node of a level
+  *             is inspected, the walk stops once all of them have been seen.
+  * @return     Number of ticks or RTCOS_NO_DEADLINE if the wheel is empty
+  ********************************************************************************************** */
+static uint32_t _rtcos_wheel_ticks_to_next_expiry(void)
+{
+  rtcos_wheel_node_t *pstNode;
+  uint32_t u32Best;
+  uint32_t u32Current;
+  uint32_t u32Slot;
+  uint32_t u32Offset;
+  uint16_t u16Remaining;
+  uint8_t u08Level;
+
+  u32Best = RTCOS_NO_DEADLINE;
+  for(u08Level = 0; u08Level < RTCOS_TIMING_WHEEL_LEVELS; ++u08Level)
+  {
+    u16Remaining = RTCOSi_stMain.tu16WheelLevelCount[u08Level];
+    u32Current = RTCOSi_stMain.u32WheelTick >> (RTCOS_TIMING_WHEEL_SLOT_BITS * u08Level);
+    for(u32Offset = 1; (0 != u16Remaining) && (u32Offset <= RTCOS_WHEEL_SLOTS_COUNT); ++u32Offset)
+    {
+      u32Slot = (u32Current + u32Offset) & RTCOS_WHEEL_SLOT_MASK;
+      for(pstNode = RTCOSi_stMain.tpstWheel[u08Level][u32Slot]; pstNode; pstNode = pstNode->pstNext)
+      {
+        if((pstNode->u32ExpiryTick - RTCOSi_stMain.u32WheelTick) < u32Best)
+        {
+          u32Best = pstNode->u32ExpiryTick - RTCOSi_stMain.u32WheelTick;
+        }
+        --u16Remaining;
+      }
+    }
+  }
+  return u32Best;
+}
+
+/** ***********************************************************************************************
+  * @brief      Move the wheel forward without processing ticks on which nothing can happen:
+  *             no node expires and no level needs to be cascaded
+  * @param      u32MaxTicks Maximum number of ticks to skip
+  * @return     Number of skipped ticks
+  ********************************************************************************************** */
+static uint32_t _rtcos_wheel_skip_ticks(uint32_t u32MaxTicks)
+{
+  uint32_t u32Distance;
+  uint32_t u32Offset;
+  uint8_t u08Level;
+
+  for(u08Level = 0;
+      (u08Level < RTCOS_TIMING_WHEEL_LEVELS) && (0 == RTCOSi_stMain.tu16WheelLevelCount[u08Level]);
+      ++u08Level);
+  if(u08Level < RTCOS_TIMING_WHEEL_LEVELS)
+  {
+    /* Distance to the next tick that cascades the first non empty level */
+    u32Offset = RTCOS_TIMING_WHEEL_SLOT_BITS * ((0 == u08Level) ? 1 : u08Level);
+    u32Distance = (1uL << u32Offset) - (RTCOSi_stMain.u32WheelTick & ((1uL << u32Offset) - 1));
+    if(0 == u08Level)
+    {
+      for(u32Offset = 1; u32Offset < u32Distance; ++u32Offset)
+      {
+        if(RTCOSi_stMain.tpstWheel[0][(RTCOSi_stMain.u32WheelTick + u32Offset) &
+                                       RTCOS_WHEEL_SLOT_MASK])
+        {
+          u32Distance = u32Offset;
+          break;
+        }
+      }
+    }
+    if((u32Distance - 1) < u32MaxTicks)
+    {
+      u32MaxTicks = u32Distance - 1;
+    }
+  }
+  RTCOSi_stMain.u32WheelTick += u32MaxTicks;
+  return u32MaxTicks;
+}
+#endif /* RTCOS_ENABLE_TICKLESS */
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+
+/** ***********************************************************************************************
+  * @brief      Search for a used event that has the requested task ID and event flag,
+  *             only the events pending for that task are visited
+  * @param      u08TaskID ID of the task using this fifo
+  * @param      u32EventFlags Bit feild event
+  * @param      pu16FoundEventIdx This will hold the index the event if found
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_find_future_event(uint8_t u08TaskID,
+                                               uint32_t u32EventFlags,
+                                               uint16_t *pu16FoundEventIdx)
+{
+  uint16_t u16Index;
+  rtcos_status_t eRetVal;
+
+  eRetVal = RTCOS_ERR_NOT_FOUND;
+  for(u16Index = RTCOSi_stMain.tstTasks[u08TaskID].u16FutureEvents;
+      RTCOS_FUTURE_EVENT_NONE != u16Index;
+      u16Index = RTCOSi_stMain.tstFutureEvents[u16Index].u16Next)
+  {
+    if(RTCOSi_stMain.tstFutureEvents[u16Index].u32EventFlags == u32EventFlags)
+    {
+      *pu16FoundEventIdx = u16Index;
+      eRetVal = RTCOS_ERR_NONE;
+      break;
+    }
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Search for a used event that has the requested task ID and event flag and delete it
+  * @param      u08TaskID ID of the task using this fifo
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_delete_future_event(uint8_t u08TaskID, uint32_t u32EventFlags)
+{
+  rtcos_status_t eRetVal;
+  uint16_t u16FoundEventIdx;
+
+  eRetVal = _rtcos_find_future_event(u08TaskID, u32EventFlags, &u16FoundEventIdx);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+    _rtcos_wheel_remove(&RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].stNode);
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+    _rtcos_release_future_event(u16FoundEventIdx);
+    if(RTCOSi_stMain.u16FutureEventsCount > 0)
+    {
+      RTCOSi_stMain.u16FutureEventsCount--;
+    }
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Take an unused event from the free list and link it to the list of a task
+  * @param      u08TaskID ID of the task using this event
+  * @param      pu16FoundEventIdx ID of the the found unused event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_alloc_future_event(uint8_t u08TaskID, uint16_t *pu16FoundEventIdx)
+{
+  uint16_t u16Index;
+  rtcos_status_t eRetVal;
+
+  u16Index = RTCOSi_stMain.u16FreeFutureEvents;
+  if(RTCOS_FUTURE_EVENT_NONE == u16Index)
+  {
+    eRetVal = RTCOS_ERR_NOT_FOUND;
+  }
+  else
+  {
+    RTCOSi_stMain.u16FreeFutureEvents = RTCOSi_stMain.tstFutureEvents[u16Index].u16Next;
+    RTCOSi_stMain.tstFutureEvents[u16Index].u16Prev = RTCOS_FUTURE_EVENT_NONE;
+    RTCOSi_stMain.tstFutureEvents[u16Index].u16Next =
+      RTCOSi_stMain.tstTasks[u08TaskID].u16FutureEvents;
+    if(RTCOS_FUTURE_EVENT_NONE != RTCOSi_stMain.tstTasks[u08TaskID].u16FutureEvents)
+    {
+      RTCOSi_stMain.tstFutureEvents[RTCOSi_stMain.tstTasks[u08TaskID].u16FutureEvents].u16Prev =
+        u16Index;
+    }
+    RTCOSi_stMain.tstTasks[u08TaskID].u16FutureEvents = u16Index;
+    *pu16FoundEventIdx = u16Index;
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Schedule a future event if there is space in the future event
+  *             array. First look if there is already a future event
+  *             in the array, if not find an empty spot.
+  * @param      u08TaskID ID of the task using this event
+  * @param      u32EventFlags Bit feild event
+  * @param      u32EventDelay How long to wait before sending event, if 0 send immediately
+  * @param      bPeriodicEvent Indicates whether to send this event periodically or not
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_add_future_event(uint8_t u08TaskID,
+                                              uint32_t u32EventFlags,
+                                              uint32_t u32EventDelay,
+                                              bool bPeriodicEvent)
+{
+  uint16_t u16FoundEventIdx;
+  rtcos_status_t eRetVal;
+
+  RTCOS_ENTER_CRITICAL_SECTION();
+  eRetVal = _rtcos_find_future_event(u08TaskID, u32EventFlags, &u16FoundEventIdx);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+    _rtcos_wheel_remove(&RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].stNode);
+    RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].stNode.u32ExpiryTick =
+      RTCOSi_stMain.u32WheelTick + RTCOS_PENDING_TICKS + u32EventDelay;
+    _rtcos_wheel_insert(&RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].stNode);
+#else
+    RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].u32EventDelay =
+      RTCOS_PENDING_TICKS + u32EventDelay;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+  }
+  else
+  {
+    eRetVal = _rtcos_alloc_future_event(u08TaskID, &u16FoundEventIdx);
+    if(RTCOS_ERR_NONE == eRetVal)
+    {
+      RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].bInUse = true;
+#ifndef RTCOS_ENABLE_TIMING_WHEEL
+      RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].u32EventDelay =
+        RTCOS_PENDING_TICKS + u32EventDelay;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+      RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].u08TaskID = u08TaskID;
+      RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].u32EventFlags = u32EventFlags;
+      ++RTCOSi_stMain.u16FutureEventsCount;
+      if(true == bPeriodicEvent)
+      {   
+        RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].u32ReloadDelay = u32EventDelay;
+      }
+      else
+      {
+        RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].u32ReloadDelay = 0;
+      }
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+      RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].stNode.u32ExpiryTick =
+        RTCOSi_stMain.u32WheelTick + RTCOS_PENDING_TICKS + u32EventDelay;
+      _rtcos_wheel_insert(&RTCOSi_stMain.tstFutureEvents[u16FoundEventIdx].stNode);
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+    }
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Find if there are any set events
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_count_events(uint32_t u32EventFlags)
+{
+  return (u32EventFlags)?RTCOS_ERR_NONE:RTCOS_ERR_NO_EVENT;
+}
+
+/** ***********************************************************************************************
+  * @brief      Check the inputs to the event routines
+  * @param      u08TaskID ID of the task using this event
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_check_event_input(uint8_t u08TaskID, uint32_t u32EventFlags)
+{
+  rtcos_status_t eRetVal;
+
+  eRetVal = _rtcos_count_events(u32EventFlags);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    if(false == RTCOS_TASK_EXISTS(u08TaskID))
+    {
+      eRetVal = RTCOS_ERR_INVALID_TASK;
+    }
+  }
+  return eRetVal;
+}
+
+#ifdef RTCOS_ENABLE_TIMERS
+/** ***********************************************************************************************
+  * @brief      Resolve a timer handle to its slot, must be called inside a critical section
+  * @param      sTimerID Handle returned by rtcos_create_timer()
+  * @param      pu08Index Where the slot of the timer is written
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+static rtcos_status_t _rtcos_timer_lookup(rtcos_timer_id_t sTimerID, uint8_t *pu08Index)
+{
+  rtcos_status_t eRetVal;
+  uint8_t u08Index;
+
+  u08Index = RTCOS_TIMER_INDEX(sTimerID);
+  if((sTimerID < 0) || (u08Index >= RTCOS_MAX_TIMERS_COUNT))
+  {
+    eRetVal = RTCOS_ERR_OUT_OF_RESOURCES;
+  }
+  else if((!RTCOSi_stMain.tstTimers[u08Index].bCreated) ||
+          (RTCOS_TIMER_STALE(sTimerID, u08Index)))
+  {
+    /* Deleted timer, its slot may already be held by another one */
+    eRetVal = RTCOS_ERR_NOT_FOUND;
+  }
+  else
+  {
+    *pu08Index = u08Index;
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_TIMERS */
+
+#if defined(RTCOS_ENABLE_TIMERS) && !defined(RTCOS_ENABLE_TIMING_WHEEL)
+/** ***********************************************************************************************
+  * @brief      Link a timer at the head of the active list, must be called inside a critical
+  *             section
+  * @param      u08Index Slot of the started timer
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_timer_link(uint8_t u08Index)
+{
+  RTCOSi_stMain.tstTimers[u08Index].u08Prev = RTCOS_TIMER_NONE;
+  RTCOSi_stMain.tstTimers[u08Index].u08Next = RTCOSi_stMain.u08ActiveTimers;
+  if(RTCOS_TIMER_NONE != RTCOSi_stMain.u08ActiveTimers)
+  {
+    RTCOSi_stMain.tstTimers[RTCOSi_stMain.u08ActiveTimers].u08Prev = u08Index;
+  }
+  RTCOSi_stMain.u08ActiveTimers = u08Index;
+}
+
+/** ***********************************************************************************************
+  * @brief      Remove a timer from the active list, a scan in progress skips over it,
+  *             must be called inside a critical section
+  * @param      u08Index Slot of the stopped timer
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_timer_unlink(uint8_t u08Index)
+{
+  uint8_t u08Prev;
+  uint8_t u08Next;
+
+  u08Prev = RTCOSi_stMain.tstTimers[u08Index].u08Prev;
+  u08Next = RTCOSi_stMain.tstTimers[u08Index].u08Next;
+  if(RTCOS_TIMER_NONE == u08Prev)
+  {
+    RTCOSi_stMain.u08ActiveTimers = u08Next;
+  }
+  else
+  {
+    RTCOSi_stMain.tstTimers[u08Prev].u08Next = u08Next;
+  }
+  if(RTCOS_TIMER_NONE != u08Next)
+  {
+    RTCOSi_stMain.tstTimers[u08Next].u08Prev = u08Prev;
+  }
+  if(u08Index == RTCOSi_stMain.u08TimerScanNext)
+  {
+    RTCOSi_stMain.u08TimerScanNext = u08Next;
+  }
+}
+
+/** ***********************************************************************************************
+  * @brief      Check if an os software timer has expired, must be called inside a critical section
+  * @param      u08TimerID ID of the timer to check
+  * @param      u32CurrentTicksCount Tick count to compare the timer start with
+  * @return     true if timer has expired, else false
+  ********************************************************************************************** */
+static bool _rtcos_timer_expired(uint8_t u08TimerID, uint32_t u32CurrentTicksCount)
+{
+  bool bExpired;
+
+  bExpired = false;
+  if((u08TimerID < RTCOS_MAX_TIMERS_COUNT) && (RTCOSi_stMain.tstTimers[u08TimerID].bInUse))
+  {
+    if((u32CurrentTicksCount - RTCOSi_stMain.tstTimers[u08TimerID].u32StartTickCount) >
+       RTCOS_TIMER_DELAY(&RTCOSi_stMain.tstTimers[u08TimerID]))
+    {
+      bExpired = true;
+    }
+  }
+  return bExpired;
+}
+#endif /* RTCOS_ENABLE_TIMERS && !RTCOS_ENABLE_TIMING_WHEEL */
+
+/** ***********************************************************************************************
+  * @brief      Advance the system tick count, with RTCOS_ENABLE_TIME64 the wraps are counted in
+  *             the high word and the update is published through the time sequence
+  * @param      u32Ticks Number of elapsed ticks
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_add_ticks(uint32_t u32Ticks)
+{
+#ifdef RTCOS_ENABLE_TIME64
+  uint32_t u32Ticks0;
+
+  _rtcos_seq_write_begin(&RTCOSi_stMain.u32TimeSequence);
+  u32Ticks0 = RTCOSi_stMain.u32SysTicksCount;
+  RTCOSi_stMain.u32SysTicksCount = u32Ticks0 + u32Ticks;
+  if(RTCOSi_stMain.u32SysTicksCount < u32Ticks0)
+  {
+    ++RTCOSi_stMain.u32SysTicksHigh;
+  }
+  _rtcos_seq_write_end(&RTCOSi_stMain.u32TimeSequence);
+#else
+  RTCOSi_stMain.u32SysTicksCount += u32Ticks;
+#endif /* RTCOS_ENABLE_TIME64 */
+}
+
+/** ***********************************************************************************************
+  * @brief      Expire the future events and timers that are due on the current tick,
+  *             must be called inside a critical section
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_process_tick(void)
+{
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+  RTCOS_TRACE(RTCOS_TRACE_TICK_START, RTCOS_TRACE_NO_TASK, RTCOS_EXPIRY_TICKS_COUNT);
+  _rtcos_wheel_process_tick();
+  RTCOS_TRACE(RTCOS_TRACE_TICK_END, RTCOS_TRACE_NO_TASK, RTCOS_EXPIRY_TICKS_COUNT);
+#else
+  uint16_t u16Index;
+#ifdef RTCOS_ENABLE_TIMERS
+  uint8_t u08Index;
+#endif /* RTCOS_ENABLE_TIMERS */
+
+  RTCOS_TRACE(RTCOS_TRACE_TICK_START, RTCOS_TRACE_NO_TASK, RTCOS_EXPIRY_TICKS_COUNT);
+  for(u16Index = 0; u16Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u16Index)
+  {
+    if(true == RTCOSi_stMain.tstFutureEvents[u16Index].bInUse)
+    {
+      --RTCOSi_stMain.tstFutureEvents[u16Index].u32EventDelay;
+      if(0 == RTCOSi_stMain.tstFutureEvents[u16Index].u32EventDelay)
+      {
+        if(RTCOSi_stMain.u16FutureEventsCount > 0)
+        {
+          RTCOSi_stMain.u16FutureEventsCount--;
+        }
+        RTCOS_EVENT_COUNTS_POST(RTCOSi_stMain.tstFutureEvents[u16Index].u08TaskID,
+                                RTCOSi_stMain.tstFutureEvents[u16Index].u32EventFlags);
+        RTCOS_TASK_EVENTS_SET(RTCOSi_stMain.tstFutureEvents[u16Index].u08TaskID,
+                              RTCOSi_stMain.tstFutureEvents[u16Index].u32EventFlags);
+        RTCOS_TRACE(RTCOS_TRACE_EVENT_POST, RTCOSi_stMain.tstFutureEvents[u16Index].u08TaskID,
+                    RTCOSi_stMain.tstFutureEvents[u16Index].u32EventFlags);
+        _rtcos_set_task_ready(RTCOSi_stMain.tstFutureEvents[u16Index].u08TaskID);
+        if(0 == RTCOSi_stMain.tstFutureEvents[u16Index].u32ReloadDelay)
+        {
+          _rtcos_release_future_event(u16Index);
+        }
+        else
+        {
+          RTCOSi_stMain
+            .tstFutureEvents[u16Index]
+              .u32EventDelay = RTCOSi_stMain.tstFutureEvents[u16Index].u32ReloadDelay;
+        }
+      }
+    }
+  }
+#ifdef RTCOS_ENABLE_TIMERS
+  /* Only the running timers are scanned, a callback may stop, delete or start any timer */
+  u08Index = RTCOSi_stMain.u08ActiveTimers;
+  while(RTCOS_TIMER_NONE != u08Index)
+  {
+    RTCOSi_stMain.u08TimerScanNext = RTCOSi_stMain.tstTimers[u08Index].u08Next;
+    if(_rtcos_timer_expired(u08Index, RTCOS_EXPIRY_TICKS_COUNT))
+    {
+      /* The timer is re-armed before its callback so that the callback can restart it */
+      if(RTCOS_TIMER_ONE_SHOT == RTCOSi_stMain.tstTimers[u08Index].ePeriodType)
+      {
+        RTCOSi_stMain.tstTimers[u08Index].bInUse = false;
+        _rtcos_timer_unlink(u08Index);
+      }
+      RTCOSi_stMain.tstTimers[u08Index].u32StartTickCount = RTCOS_EXPIRY_TICKS_COUNT;
+      RTCOS_TIMER_CLEAR_START_DELAY(&RTCOSi_stMain.tstTimers[u08Index]);
+      if(RTCOSi_stMain.tstTimers[u08Index].pfTimerCb)
+      {
+        RTCOS_TRACE(RTCOS_TRACE_TIMER_START, RTCOS_TRACE_NO_TASK, u08Index);
+        RTCOS_TIMER_CB_PROLOGUE();
+        RTCOSi_stMain.tstTimers[u08Index].pfTimerCb(RTCOSi_stMain.tstTimers[u08Index].pvArg);
+        RTCOS_TIMER_CB_EPILOGUE();
+        RTCOS_TRACE(RTCOS_TRACE_TIMER_END, RTCOS_TRACE_NO_TASK, u08Index);
+      }
+    }
+    u08Index = RTCOSi_stMain.u08TimerScanNext;
+  }
+  RTCOSi_stMain.u08TimerScanNext = RTCOS_TIMER_NONE;
+#endif /* RTCOS_ENABLE_TIMERS */
+  RTCOS_TRACE(RTCOS_TRACE_TICK_END, RTCOS_TRACE_NO_TASK, RTCOS_EXPIRY_TICKS_COUNT);
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+}
+
+#ifdef RTCOS_ENABLE_TICKLESS
+/** ***********************************************************************************************
+  * @brief      Get the number of ticks until the earliest future event or timer expiry,
+  *             must be called inside a critical section
+  * @return     Number of ticks or RTCOS_NO_DEADLINE if nothing is scheduled
+  ********************************************************************************************** */
+static uint32_t _rtcos_ticks_to_next_deadline(void)
+{
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+  return _rtcos_wheel_ticks_to_next_expiry();
+#else
+  uint32_t u32Best;
+  uint16_t u16Index;
+#ifdef RTCOS_ENABLE_TIMERS
+  uint32_t u32Remaining;
+  uint8_t u08Index;
+#endif /* RTCOS_ENABLE_TIMERS */
+
+  u32Best = RTCOS_NO_DEADLINE;
+  for(u16Index = 0; u16Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u16Index)
+  {
+    if((true == RTCOSi_stMain.tstFutureEvents[u16Index].bInUse) &&
+       (RTCOSi_stMain.tstFutureEvents[u16Index].u32EventDelay < u32Best))
+    {
+      u32Best = RTCOSi_stMain.tstFutureEvents[u16Index].u32EventDelay;
+    }
+  }
+#ifdef RTCOS_ENABLE_TIMERS
+  for(u08Index = RTCOSi_stMain.u08ActiveTimers; RTCOS_TIMER_NONE != u08Index;
+      u08Index = RTCOSi_stMain.tstTimers[u08Index].u08Next)
+  {
+    /* A timer expires once more than u32TickDelay ticks have elapsed since its start */
+    u32Remaining = (RTCOSi_stMain.tstTimers[u08Index].u32StartTickCount +
+                    RTCOS_TIMER_DELAY(&RTCOSi_stMain.tstTimers[u08Index]) + 1) -
+                   RTCOS_EXPIRY_TICKS_COUNT;
+    if(u32Remaining < u32Best)
+    {
+      u32Best = u32Remaining;
+    }
+  }
+#endif /* RTCOS_ENABLE_TIMERS */
+  return u32Best;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+}
+
+/** ***********************************************************************************************
+  * @brief      Advance the time by up to u32MaxTicks ticks during which nothing expires,
+  *             must be called inside a critical section
+  * @param      u32MaxTicks Maximum number of ticks to skip
+  * @return     Number of skipped ticks
+  ********************************************************************************************** */
+static uint32_t _rtcos_skip_ticks(uint32_t u32MaxTicks)
+{
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+  u32MaxTicks = _rtcos_wheel_skip_ticks(u32MaxTicks);
+#else
+  uint32_t u32Distance;
+  uint16_t u16Index;
+
+  u32Distance = _rtcos_ticks_to_next_deadline();
+  /* A deadline that is already due must be processed, nothing can be skipped */
+  if(0 == u32Distance)
+  {
+    u32MaxTicks = 0;
+  }
+  else if((u32Distance - 1) < u32MaxTicks)
+  {
+    u32MaxTicks = u32Distance - 1;
+  }
+  for(u16Index = 0; u16Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u16Index)
+  {
+    if(true == RTCOSi_stMain.tstFutureEvents[u16Index].bInUse)
+    {
+      RTCOSi_stMain.tstFutureEvents[u16Index].u32EventDelay -= u32MaxTicks;
+    }
+  }
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+  RTCOS_EXPIRY_TICKS_ADD(u32MaxTicks);
+  return u32MaxTicks;
+}
+#endif /* RTCOS_ENABLE_TICKLESS */
+
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+/** ***********************************************************************************************
+  * @brief      Timer service: process the ticks counted by rtcos_update_tick() since the last
+  *             call. Runs from rtcos_run() and unmasks interrupts between two ticks and around
+  *             each timer callback.
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _rtcos_service_ticks(void)
+{
+  uint32_t u32PendingTicks;
+
+  RTCOS_ENTER_CRITICAL_SECTION();
+  u32PendingTicks = RTCOSi_stMain.u32SysTicksCount - RTCOSi_stMain.u32ProcessedTicksCount;
+  while(u32PendingTicks > 0)
+  {
+#ifdef RTCOS_ENABLE_TICKLESS
+    u32PendingTicks -= _rtcos_skip_ticks(u32PendingTicks);
+    if(0 == u32PendingTicks)
+    {
+      break;
+    }
+#endif /* RTCOS_ENABLE_TICKLESS */
+    ++RTCOSi_stMain.u32ProcessedTicksCount;
+    _rtcos_process_tick();
+    --u32PendingTicks;
+    RTCOS_EXIT_CRITICAL_SECTION();
+    RTCOS_ENTER_CRITICAL_SECTION();
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
+}
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported functions                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Initialize rtcos main context, this should be called before any other os calls
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_init(void)
+{
+  uint8_t u08Index;
+  uint16_t u16Index;
+
+  for(u08Index = 0; u08Index < RTCOS_MAX_TASKS_COUNT; ++u08Index)
+  {
+#ifndef RTCOS_ENABLE_STATIC_TASKS
+    RTCOSi_stMain.tstTasks[u08Index].pfTaskHandlerCb = NULL;
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+    RTCOSi_stMain.tstTasks[u08Index].u16FutureEvents = RTCOS_FUTURE_EVENT_NONE;
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+    RTCOSi_stMain.tstTasks[u08Index].u32CountedEvents = 0;
+    RTCOSi_stMain.tstTasks[u08Index].u32RunEvents = 0;
+    _rtcos_event_counts_clear(u08Index, 0xFFFFFFFFuL);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+    /* Tasks keep the order of their IDs until a priority is given to them */
+    RTCOSi_stMain.tu08TaskPriority[u08Index] = (u08Index < RTCOS_PRIORITY_LEVELS_COUNT) ?
+                                               u08Index : (RTCOS_PRIORITY_LEVELS_COUNT - 1);
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+    RTCOSi_stMain.tstTasks[u08Index].u32ReadySince = 0;
+    RTCOSi_stMain.tstTasks[u08Index].u32MaxWaitTicks = 0;
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+    RTCOSi_stMain.tstTasks[u08Index].u32RelativeDeadline = 0;
+    RTCOSi_stMain.tstTasks[u08Index].u32Deadline = 0;
+    RTCOSi_stMain.tstTasks[u08Index].u32RunDeadline = 0;
+    RTCOSi_stMain.tstTasks[u08Index].bRunHasDeadline = false;
+    RTCOSi_stMain.tstTasks[u08Index].u32DeadlineMisses = 0;
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+    atomic_init(&RTCOSi_stMain.tstTasks[u08Index].u32EventFlags, 0);
+#else
+    RTCOSi_stMain.tstTasks[u08Index].u32EventFlags = 0;
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+#ifdef RTCOS_ENABLE_MESSAGES
+    _rtcos_fifo_init(u08Index);
+#endif /* RTCOS_ENABLE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+    _rtcos_ring_init(u08Index);
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+#ifdef RTCOS_ENABLE_WORKERS
+    atomic_init(&RTCOSi_stMain.tstTasks[u08Index].u08State, RTCOS_TASK_STATE_IDLE);
+#endif /* RTCOS_ENABLE_WORKERS */
+#ifdef RTCOS_ENABLE_STATS
+    atomic_init(&RTCOSi_stMain.tstTasks[u08Index].u32StatsSequence, 0);
+    RTCOSi_stMain.tstTasks[u08Index].stStats.u32DispatchCount = 0;
+    RTCOSi_stMain.tstTasks[u08Index].stStats.u32EventsCount = 0;
+    RTCOSi_stMain.tstTasks[u08Index].stStats.u32MessagesCount = 0;
+    RTCOSi_stMain.tstTasks[u08Index].stStats.u32MaxRunTime = 0;
+    RTCOSi_stMain.tstTasks[u08Index].stStats.u64TotalRunTime = 0;
+    RTCOSi_stMain.tstTasks[u08Index].u32MessagesTaken = 0;
+#endif /* RTCOS_ENABLE_STATS */
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+    RTCOSi_stMain.tstTasks[u08Index].stOverruns.u32Budget = 0;
+    RTCOSi_stMain.tstTasks[u08Index].stOverruns.u32OverrunsCount = 0;
+    RTCOSi_stMain.tstTasks[u08Index].stOverruns.u32LastEventFlags = 0;
+    RTCOSi_stMain.tstTasks[u08Index].stOverruns.u32LastRunTime = 0;
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+  }
+  for(u16Index = 0; u16Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u16Index)
+  {
+    RTCOSi_stMain.tstFutureEvents[u16Index].bInUse = false;
+    RTCOSi_stMain.tstFutureEvents[u16Index].u08TaskID = 0;
+    RTCOSi_stMain.tstFutureEvents[u16Index].u32EventFlags = 0;
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+    RTCOSi_stMain.tstFutureEvents[u16Index].stNode.pstNext = NULL;
+    RTCOSi_stMain.tstFutureEvents[u16Index].stNode.ppstPrev = NULL;
+    RTCOSi_stMain.tstFutureEvents[u16Index].stNode.u08Kind = RTCOS_WHEEL_NODE_EVENT;
+#else
+    RTCOSi_stMain.tstFutureEvents[u16Index].u32EventDelay = 0;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+    RTCOSi_stMain.tstFutureEvents[u16Index].u32ReloadDelay = 0;
+    RTCOSi_stMain.tstFutureEvents[u16Index].u16Next = (uint16_t)(u16Index + 1);
+  }
+  RTCOSi_stMain.tstFutureEvents[RTCOS_MAX_FUTURE_EVENTS_COUNT - 1].u16Next =
+    RTCOS_FUTURE_EVENT_NONE;
+  RTCOSi_stMain.u16FreeFutureEvents = 0;
+#ifdef RTCOS_ENABLE_TIMERS
+  for(u08Index = 0; u08Index < RTCOS_MAX_TIMERS_COUNT; ++u08Index)
+  {
+    RTCOSi_stMain.tstTimers[u08Index].u32StartTickCount = 0;
+    RTCOSi_stMain.tstTimers[u08Index].u32TickDelay = 0;
+    RTCOSi_stMain.tstTimers[u08Index].bInUse = false;
+    RTCOSi_stMain.tstTimers[u08Index].pfTimerCb = NULL;
+    RTCOSi_stMain.tstTimers[u08Index].pvArg = NULL;
+    RTCOSi_stMain.tstTimers[u08Index].bCreated = false;
+#ifdef RTCOS_ENABLE_TIMER_HANDLES
+    RTCOSi_stMain.tstTimers[u08Index].u08Generation = 1;
+#endif /* RTCOS_ENABLE_TIMER_HANDLES */
+    RTCOSi_stMain.tstTimers[u08Index].u08Next = (uint8_t)(u08Index + 1);
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+    RTCOSi_stMain.tstTimers[u08Index].stNode.pstNext = NULL;
+    RTCOSi_stMain.tstTimers[u08Index].stNode.ppstPrev = NULL;
+    RTCOSi_stMain.tstTimers[u08Index].stNode.u08Kind = RTCOS_WHEEL_NODE_TIMER;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+  }
+  RTCOSi_stMain.tstTimers[RTCOS_MAX_TIMERS_COUNT - 1].u08Next = RTCOS_TIMER_NONE;
+  RTCOSi_stMain.u08FreeTimers = 0;
+#ifndef RTCOS_ENABLE_TIMING_WHEEL
+  RTCOSi_stMain.u08ActiveTimers = RTCOS_TIMER_NONE;
+  RTCOSi_stMain.u08TimerScanNext = RTCOS_TIMER_NONE;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+  RTCOSi_stMain.u08TimersCount = 0;
+#endif /* RTCOS_ENABLE_TIMERS */
+  for(u08Index = 0; u08Index < RTCOS_READY_WORDS_COUNT; ++u08Index)
+  {
+    RTCOSi_stMain.stReadyMap.tu32Map[u08Index] = 0;
+#ifdef RTCOS_ENABLE_PENDING_READY_MAP
+    atomic_init(&RTCOSi_stMain.tu32PendingMap[u08Index], 0);
+#endif /* RTCOS_ENABLE_PENDING_READY_MAP */
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+    RTCOSi_stMain.tu32AgedMap[u08Index] = 0;
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+    RTCOSi_stMain.tu32DeadlineMap[u08Index] = 0;
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+  }
+#if (RTCOS_READY_WORDS_COUNT > 1)
+  RTCOSi_stMain.stReadyMap.u32GroupMap = 0;
+#endif /* RTCOS_READY_WORDS_COUNT */
+#if defined(RTCOS_ENABLE_TASK_PRIORITIES) && !defined(RTCOS_ENABLE_WORKERS)
+  for(u08Index = 0; u08Index < RTCOS_PRIORITY_LEVELS_COUNT; ++u08Index)
+  {
+    for(u16Index = 0; u16Index < RTCOS_READY_WORDS_COUNT; ++u16Index)
+    {
+      RTCOSi_stMain.tu32LevelTasks[u08Index][u16Index] = 0;
+    }
+  }
+  RTCOSi_stMain.u32LevelMap = 0;
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES && !RTCOS_ENABLE_WORKERS */
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+  /* The first turn of each level goes to its lowest task ID */
+  for(u08Index = 0; u08Index < RTCOS_PRIORITY_LEVELS_COUNT; ++u08Index)
+  {
+    RTCOSi_stMain.tu08LastTask[u08Index] = (uint8_t)((RTCOS_READY_WORDS_COUNT * 32) - 1);
+  }
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+  RTCOSi_stMain.u32AgingTick = 0;
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+  for(u08Index = 0; u08Index < RTCOS_TIMING_WHEEL_LEVELS; ++u08Index)
+  {
+    for(u16Index = 0; u16Index < RTCOS_WHEEL_SLOTS_COUNT; ++u16Index)
+    {
+      RTCOSi_stMain.tpstWheel[u08Index][u16Index] = NULL;
+    }
+    RTCOSi_stMain.tu16WheelLevelCount[u08Index] = 0;
+  }
+  RTCOSi_stMain.u32WheelTick = 0;
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+#ifdef RTCOS_ENABLE_WORKERS
+  for(u08Index = 0; u08Index < RTCOS_WORKERS_COUNT; ++u08Index)
+  {
+    for(u16Index = 0; u16Index < RTCOS_WORKER_PRIORITY_BANDS; ++u16Index)
+    {
+      atomic_init(&RTCOSi_stMain.tstWorkers[u08Index].tstDeques[u16Index].u32Top, 0);
+      atomic_init(&RTCOSi_stMain.tstWorkers[u08Index].tstDeques[u16Index].u32Bottom, 0);
+    }
+  }
+  atomic_init(&RTCOSi_stMain.s32QueuedCount, 0);
+  atomic_init(&RTCOSi_stMain.s32SleepersCount, 0);
+  pthread_mutex_init(&RTCOSi_stMain.stSleepMutex, NULL);
+  pthread_cond_init(&RTCOSi_stMain.stSleepCond, NULL);
+#endif /* RTCOS_ENABLE_WORKERS */
+#ifdef RTCOS_ENABLE_TRACE
+  atomic_init(&RTCOSi_stMain.bTraceEnabled, true);
+#endif /* RTCOS_ENABLE_TRACE */
+#ifdef RTCOS_ENABLE_STATS
+  for(u08Index = 0; u08Index < RTCOS_STATS_LOOPS_COUNT; ++u08Index)
+  {
+    atomic_init(&RTCOSi_stMain.tstLoopTimes[u08Index].u32Sequence, 0);
+    RTCOSi_stMain.tstLoopTimes[u08Index].u64BusyTime = 0;
+    RTCOSi_stMain.tstLoopTimes[u08Index].u64IdleTime = 0;
+  }
+#endif /* RTCOS_ENABLE_STATS */
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+  _rtcos_msg_pools_init();
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+  RTCOSi_stMain.u08CurrentTaskID = 0;
+  RTCOSi_stMain.u32SysTicksCount = 0;
+#ifdef RTCOS_ENABLE_TIME64
+  RTCOSi_stMain.u32SysTicksHigh = 0;
+  atomic_init(&RTCOSi_stMain.u32TimeSequence, 0);
+#endif /* RTCOS_ENABLE_TIME64 */
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+  RTCOSi_stMain.u32ProcessedTicksCount = 0;
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+  RTCOSi_stMain.u16FutureEventsCount = 0;
+#ifdef RTCOS_ENABLE_STATIC_TASKS
+  /* Every task of the table exists from the start, there is nothing to register. Entries without
+   * a handler keep their ID but are skipped by RTCOS_TASK_EXISTS() */
+  RTCOSi_stMain.u08TasksCount = RTCOS_u08StaticTasksCount;
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+  RTCOSi_stMain.pfIdleHandler = NULL;
+}
+
+#ifndef RTCOS_ENABLE_STATIC_TASKS
+/** ***********************************************************************************************
+  * @brief      Register a task handler if there is space
+  * @param      pfTaskHandler task handler function
+  * @param      u08TaskID ID of this task
+  * @param      pvArg Task argument
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_register_task_handler(pf_os_task_handler_t pfTaskHandler,
+                                           uint8_t u08TaskID,
+                                           void *pvArg)
+{
+  rtcos_status_t eRetVal;
+
+  if(u08TaskID < RTCOS_MAX_TASKS_COUNT)
+  {
+    if(RTCOSi_stMain.tstTasks[u08TaskID].pfTaskHandlerCb != NULL)
+    {
+      eRetVal = RTCOS_ERR_IN_USE;
+    }
+    else
+    {
+      RTCOSi_stMain.tstTasks[u08TaskID].pfTaskHandlerCb = pfTaskHandler;
+      RTCOSi_stMain.tstTasks[u08TaskID].pvArg = pvArg;
+      ++RTCOSi_stMain.u08TasksCount;
+      eRetVal = RTCOS_ERR_NONE;
+    }
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_OUT_OF_RANGE;
+  }
+  return eRetVal;
+}
+
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+/** ***********************************************************************************************
+  * @brief      Register a task handler along with its priority level
+  * @param      pfTaskHandler task handler function
+  * @param      u08TaskID ID of this task
+  * @param      pvArg Task argument
+  * @param      u08Priority Priority level of the task, 0 is the highest
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_register_task_handler_priority(pf_os_task_handler_t pfTaskHandler,
+                                                    uint8_t u08TaskID,
+                                                    void *pvArg,
+                                                    uint8_t u08Priority)
+{
+  rtcos_status_t eRetVal;
+
+  if(u08Priority >= RTCOS_PRIORITY_LEVELS_COUNT)
+  {
+    eRetVal = RTCOS_ERR_OUT_OF_RANGE;
+  }
+  else
+  {
+    eRetVal = rtcos_register_task_handler(pfTaskHandler, u08TaskID, pvArg);
+    if(RTCOS_ERR_NONE == eRetVal)
+    {
+      RTCOS_ENTER_CRITICAL_SECTION();
+      _rtcos_move_task_priority(u08TaskID, u08Priority);
+      RTCOS_EXIT_CRITICAL_SECTION();
+    }
+  }
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+
+/** ***********************************************************************************************
+  * @brief      Register an idle handler to be called when the system is idle
+  * @param      pfIdleHandler idle handler function
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_register_idle_handler(pf_os_idle_handler_t pfIdleHandler)
+{
+  rtcos_status_t eRetVal;
+
+  if(pfIdleHandler)
+  {
+    RTCOSi_stMain.pfIdleHandler = pfIdleHandler; 
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  return eRetVal;
+}
+
+#ifdef RTCOS_ENABLE_TASK_PRIORITIES
+/** ***********************************************************************************************
+  * @brief      Set the priority level of a registered task, several tasks may share a level and
+  *             the other tasks keep theirs
+  * @param      u08TaskID ID of the task
+  * @param      u08Priority New priority level, 0 is the highest
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_set_task_priority(uint8_t u08TaskID, uint8_t u08Priority)
+{
+  rtcos_status_t eRetVal;
+
+  if((u08TaskID < RTCOSi_stMain.u08TasksCount) && (u08Priority < RTCOS_PRIORITY_LEVELS_COUNT))
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    _rtcos_move_task_priority(u08TaskID, u08Priority);
+    RTCOS_EXIT_CRITICAL_SECTION();
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_OUT_OF_RANGE;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the priority level of a task
+  * @param      u08TaskID ID of the task
+  * @return     Priority level of the task, 0 is the highest, or 0xFF if the task is not registered
+  ********************************************************************************************** */
+uint8_t rtcos_get_task_priority(uint8_t u08TaskID)
+{
+  uint8_t u08RetVal;
+
+  u08RetVal = 0xFF;
+  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
+  {
+    u08RetVal = RTCOS_TASK_PRIORITY(u08TaskID);
+  }
+  return u08RetVal;
+}
+#endif /* RTCOS_ENABLE_TASK_PRIORITIES */
+
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+/** ***********************************************************************************************
+  * @brief      Get the longest time a task stayed ready before being dispatched, the current
+  *             wait of a task still ready included
+  * @param      u08TaskID ID of the task
+  * @return     Longest wait in ticks, 0 if the task is not registered
+  ********************************************************************************************** */
+uint32_t rtcos_get_task_max_wait(uint8_t u08TaskID)
+{
+  uint32_t u32RetVal;
+  uint32_t u32Wait;
+
+  u32RetVal = 0;
+  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    u32RetVal = RTCOSi_stMain.tstTasks[u08TaskID].u32MaxWaitTicks;
+    /* A task still waiting to be dispatched counts its current wait, so starvation shows */
+    if(0 != (RTCOSi_stMain.stReadyMap.tu32Map[u08TaskID >> 5] & (0x80000000uL >> (u08TaskID & 31))))
+    {
+      u32Wait = RTCOSi_stMain.u32SysTicksCount - RTCOSi_stMain.tstTasks[u08TaskID].u32ReadySince;
+      if(u32Wait > u32RetVal)
+      {
+        u32RetVal = u32Wait;
+      }
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  return u32RetVal;
+}
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+/** ***********************************************************************************************
+  * @brief      Set the relative deadline given to the work that reaches a task: events, messages
+  *             and the events it leaves unhandled are then due that many ticks later
+  * @param      u08TaskID ID of the task
+  * @param      u32RelativeDeadline Deadline in ticks, 0 leaves the task without deadline
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_set_task_deadline(uint8_t u08TaskID, uint32_t u32RelativeDeadline)
+{
+  rtcos_status_t eRetVal;
+
+  eRetVal = RTCOS_ERR_INVALID_TASK;
+  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    RTCOSi_stMain.tstTasks[u08TaskID].u32RelativeDeadline = u32RelativeDeadline;
+    RTCOS_EXIT_CRITICAL_SECTION();
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Set an event for a certain task with its own deadline, the task keeps the earliest
+  *             deadline of its pending work
+  * @param      u08TaskID ID of the task which will receive the event
+  * @param      u32EventFlags Bit feild event
+  * @param      u32Deadline Ticks from now within which the event must be handled
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_send_event_deadline(uint8_t u08TaskID,
+                                         uint32_t u32EventFlags,
+                                         uint32_t u32Deadline)
+{
+  rtcos_status_t eRetVal;
+
+  eRetVal = _rtcos_check_event_input(u08TaskID, u32EventFlags);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    RTCOS_TRACE(RTCOS_TRACE_EVENT_POST, u08TaskID, u32EventFlags);
+    RTCOS_ENTER_CRITICAL_SECTION();
+    RTCOS_EVENT_COUNTS_POST(u08TaskID, u32EventFlags);
+    RTCOS_TASK_EVENTS_SET(u08TaskID, u32EventFlags);
+    _rtcos_edf_post_deadline(u08TaskID, RTCOSi_stMain.u32SysTicksCount + u32Deadline);
+    _rtcos_set_task_ready(u08TaskID);
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the number of handler calls of a task that returned after their deadline
+  * @param      u08TaskID ID of the task
+  * @return     Number of deadline misses, 0 if the task is not registered
+  ********************************************************************************************** */
+uint32_t rtcos_get_deadline_misses(uint8_t u08TaskID)
+{
+  uint32_t u32RetVal;
+
+  u32RetVal = 0;
+  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    u32RetVal = RTCOSi_stMain.tstTasks[u08TaskID].u32DeadlineMisses;
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  return u32RetVal;
+}
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
+
+#ifdef RTCOS_ENABLE_MESSAGES
+/** ***********************************************************************************************
+  * @brief      Send a message to a task
+  * @param      u08TaskID ID of the task which will receive the message
+  * @param      pvMsg Pointer on the message to send
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_send_message(uint8_t u08TaskID, void *pvMsg)
+{
+  rtcos_status_t eRetVal;
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+  rtcos_msg_block_t *pstBlock;
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+
+  if(NULL == pvMsg)
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  else if(false == RTCOS_TASK_EXISTS(u08TaskID))
+  {
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+  else if(RTCOS_ERR_NONE != _rtcos_msg_get_block(pvMsg, &pstBlock))
+  {
+    eRetVal = RTCOS_ERR_INVALID_MSG;
+  }
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+  else
+  {
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+    /* The receiver owns a reference on a pool message until it releases it */
+    if(NULL != pstBlock)
+    {
+      _rtcos_msg_add_ref(pstBlock);
+    }
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+    eRetVal = _rtcos_fifo_push(u08TaskID, pvMsg);
+    if(RTCOS_ERR_NONE == eRetVal)
+    {
+      RTCOS_TRACE(RTCOS_TRACE_MESSAGE_PUSH, u08TaskID, (uintptr_t)pvMsg);
+      _rtcos_post_task_ready(u08TaskID);
+    }
+#else
+    RTCOS_ENTER_CRITICAL_SECTION();
+    eRetVal = _rtcos_fifo_push(u08TaskID, pvMsg);
+    if(RTCOS_ERR_NONE == eRetVal)
+    {
+      RTCOS_TRACE(RTCOS_TRACE_MESSAGE_PUSH, u08TaskID, (uintptr_t)pvMsg);
+      _rtcos_set_task_ready(u08TaskID);
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+    if((RTCOS_ERR_NONE != eRetVal) && (NULL != pstBlock))
+    {
+      _rtcos_msg_put_ref(pstBlock);
+    }
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Send a message to all tasks
+  * @param      pvMsg Pointer on the message to send
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_broadcast_message(void *pvMsg)
+{
+  uint8_t u08Index;
+  rtcos_status_t eRetVal;
+
+  eRetVal = RTCOS_ERR_NONE;
+  if(pvMsg)
+  {
+    for(u08Index = 0; u08Index < RTCOSi_stMain.u08TasksCount; ++u08Index)
+    {
+      if(RTCOS_TASK_EXISTS(u08Index))
+      {
+        eRetVal |= rtcos_send_message(u08Index, pvMsg);
+      }
+    }
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Send several messages to a task in order, taking the critical section once
+  * @param      u08TaskID ID of the task which will receive the messages
+  * @param      ppvMsgs Array of the messages to send
+  * @param      u08Count Number of messages in the array
+  * @return     Number of messages sent, it stops at the first NULL message, at the first pointer
+  *             into the pools that is not an allocated message or when the fifo is full
+  ********************************************************************************************** */
+uint8_t rtcos_send_messages(uint8_t u08TaskID, void **ppvMsgs, uint8_t u08Count)
+{
+  uint8_t u08Sent;
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+  rtcos_msg_block_t *pstBlock;
+  uint8_t u08Index;
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+
+  u08Sent = 0;
+  if((NULL != ppvMsgs) && RTCOS_TASK_EXISTS(u08TaskID))
+  {
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+    /* A pointer into the pools that is not an allocated message ends the batch like a NULL one */
+    for(u08Index = 0; (u08Index < u08Count) && (NULL != ppvMsgs[u08Index]) &&
+        (RTCOS_ERR_NONE == _rtcos_msg_get_block(ppvMsgs[u08Index], &pstBlock)); ++u08Index)
+    {
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+      if(NULL != pstBlock)
+      {
+        _rtcos_msg_add_ref(pstBlock);
+      }
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+    }
+    u08Count = u08Index;
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+    while((u08Sent < u08Count) && (NULL != ppvMsgs[u08Sent]) &&
+          (RTCOS_ERR_NONE == _rtcos_fifo_push(u08TaskID, ppvMsgs[u08Sent])))
+    {
+      RTCOS_TRACE(RTCOS_TRACE_MESSAGE_PUSH, u08TaskID, (uintptr_t)ppvMsgs[u08Sent]);
+      ++u08Sent;
+    }
+    if(u08Sent > 0)
+    {
+      _rtcos_post_task_ready(u08TaskID);
+    }
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+    /* Give back the references taken for the messages that did not fit */
+    for(u08Index = u08Sent; u08Index < u08Count; ++u08Index)
+    {
+      _rtcos_msg_get_block(ppvMsgs[u08Index], &pstBlock);
+      if(NULL != pstBlock)
+      {
+        _rtcos_msg_put_ref(pstBlock);
+      }
+    }
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+#else
+    RTCOS_ENTER_CRITICAL_SECTION();
+    while((u08Sent < u08Count) && (NULL != ppvMsgs[u08Sent]) &&
+          (RTCOS_ERR_NONE == _rtcos_fifo_push(u08TaskID, ppvMsgs[u08Sent])))
+    {
+      RTCOS_TRACE(RTCOS_TRACE_MESSAGE_PUSH, u08TaskID, (uintptr_t)ppvMsgs[u08Sent]);
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+      /* Reference counts are protected by the critical section already held here */
+      _rtcos_msg_get_block(ppvMsgs[u08Sent], &pstBlock);
+      if(NULL != pstBlock)
+      {
+        ++pstBlock->u16RefCount;
+      }
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+      ++u08Sent;
+    }
+    if(u08Sent > 0)
+    {
+      _rtcos_set_task_ready(u08TaskID);
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+  }
+  return u08Sent;
+}
+
+/** ***********************************************************************************************
+  * @brief      Retrieve a message from inside a task handler
+  * @param      ppvMsg Pointer on a pointer to retrieved message
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_get_message(void **ppvMsg)
+{
+  rtcos_status_t eRetVal;
+
+  if(RTCOS_CURRENT_TASK_ID < RTCOSi_stMain.u08TasksCount)
+  {
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+    /* The ring has a single consumer and the ready bit is refreshed when the handler returns */
+    eRetVal = _rtcos_fifo_pop(RTCOS_CURRENT_TASK_ID, ppvMsg);
+#else
+    RTCOS_ENTER_CRITICAL_SECTION();
+    eRetVal = _rtcos_fifo_pop(RTCOSi_stMain.u08CurrentTaskID, ppvMsg);
+    _rtcos_update_task_ready(RTCOSi_stMain.u08CurrentTaskID);
+    RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+#if defined(RTCOS_ENABLE_STATS) || defined(RTCOS_ENABLE_TRACE)
+    if(RTCOS_ERR_NONE == eRetVal)
+    {
+#ifdef RTCOS_ENABLE_STATS
+      ++RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].u32MessagesTaken;
+#endif /* RTCOS_ENABLE_STATS */
+      RTCOS_TRACE(RTCOS_TRACE_MESSAGE_POP, RTCOS_CURRENT_TASK_ID, (uintptr_t)*ppvMsg);
+    }
+#endif /* RTCOS_ENABLE_STATS || RTCOS_ENABLE_TRACE */
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Retrieve up to u08MaxCount messages from inside a task handler, oldest first,
+  *             taking the critical section once
+  * @param      ppvMsgs Array receiving the messages
+  * @param      u08MaxCount Size of the array
+  * @return     Number of messages retrieved, 0 when the fifo is empty
+  ********************************************************************************************** */
+uint8_t rtcos_get_messages(void **ppvMsgs, uint8_t u08MaxCount)
+{
+  uint8_t u08Count;
+#ifdef RTCOS_ENABLE_TRACE
+  uint8_t u08Index;
+#endif /* RTCOS_ENABLE_TRACE */
+
+  u08Count = 0;
+  if((NULL != ppvMsgs) && (RTCOS_CURRENT_TASK_ID < RTCOSi_stMain.u08TasksCount))
+  {
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+    while((u08Count < u08MaxCount) &&
+          (RTCOS_ERR_NONE == _rtcos_fifo_pop(RTCOS_CURRENT_TASK_ID, &ppvMsgs[u08Count])))
+    {
+      ++u08Count;
+    }
+#else
+    RTCOS_ENTER_CRITICAL_SECTION();
+    while((u08Count < u08MaxCount) &&
+          (RTCOS_ERR_NONE == _rtcos_fifo_pop(RTCOSi_stMain.u08CurrentTaskID, &ppvMsgs[u08Count])))
+    {
+      ++u08Count;
+    }
+    _rtcos_update_task_ready(RTCOSi_stMain.u08CurrentTaskID);
+    RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+#ifdef RTCOS_ENABLE_STATS
+    RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].u32MessagesTaken += u08Count;
+#endif /* RTCOS_ENABLE_STATS */
+#ifdef RTCOS_ENABLE_TRACE
+    for(u08Index = 0; u08Index < u08Count; ++u08Index)
+    {
+      RTCOS_TRACE(RTCOS_TRACE_MESSAGE_POP, RTCOS_CURRENT_TASK_ID, (uintptr_t)ppvMsgs[u08Index]);
+    }
+#endif /* RTCOS_ENABLE_TRACE */
+  }
+  return u08Count;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the oldest message from inside a task handler without removing it
+  * @param      ppvMsg Pointer on a pointer to the message
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_peek_message(void **ppvMsg)
+{
+  rtcos_status_t eRetVal;
+
+  if(RTCOS_CURRENT_TASK_ID < RTCOSi_stMain.u08TasksCount)
+  {
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+    eRetVal = _rtcos_fifo_peek(RTCOS_CURRENT_TASK_ID, ppvMsg);
+#else
+    RTCOS_ENTER_CRITICAL_SECTION();
+    eRetVal = _rtcos_fifo_peek(RTCOSi_stMain.u08CurrentTaskID, ppvMsg);
+    RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_MESSAGES */
+
+#ifdef RTCOS_ENABLE_MESSAGE_RINGS
+/** ***********************************************************************************************
+  * @brief      Reserve contiguous room for a message in the ring of a task, the caller writes the
+  *             message in place then publishes it with rtcos_ring_commit(). A ring has at most
+  *             one pending reservation.
+  * @param      u08TaskID ID of the task which will receive the message
+  * @param      u16Size Maximum size of the message in bytes, at most
+  *             RTCOS_MESSAGE_RING_SIZE - 4
+  * @return     Pointer to the reserved room, aligned on 4 bytes, or NULL if the size does not
+  *             fit the ring, the ring is full or already reserved
+  ********************************************************************************************** */
+void *rtcos_ring_reserve(uint8_t u08TaskID, uint16_t u16Size)
+{
+  rtcos_ring_t *pstRing;
+  uint32_t u32Needed;
+  uint16_t u16Offset;
+  void *pvRetVal;
+
+  pvRetVal = NULL;
+  u32Needed = RTCOS_RING_HEADER_SIZE + RTCOS_RING_ALIGN(u16Size);
+  if(RTCOS_TASK_EXISTS(u08TaskID) && (0 != u16Size) &&
+     (u16Size <= RTCOS_RING_MAX_MESSAGE_SIZE))
+  {
+    pstRing = &RTCOSi_stMain.tstTasks[u08TaskID].stRing;
+    u16Offset = RTCOS_RING_WRAP_MARK;
+    RTCOS_ENTER_CRITICAL_SECTION();
+    if(0 == pstRing->u16Reserved)
+    {
+      if(0 == pstRing->u16Used)
+      {
+        /* Restart from the beginning so that the largest message fits */
+        pstRing->u16Head = 0;
+        pstRing->u16Tail = 0;
+      }
+      if((pstRing->u16Head > pstRing->u16Tail) || (0 == pstRing->u16Used))
+      {
+        /* Free room at the end of the ring, then before the oldest message */
+        if(u32Needed <= (uint32_t)(RTCOS_MESSAGE_RING_SIZE - pstRing->u16Head))
+        {
+          u16Offset = pstRing->u16Head;
+        }
+        else if(u32Needed <= pstRing->u16Tail)
+        {
+          u16Offset = 0;
+        }
+      }
+      else if(u32Needed <= (uint32_t)(pstRing->u16Tail - pstRing->u16Head))
+      {
+        u16Offset = pstRing->u16Head;
+      }
+      if(RTCOS_RING_WRAP_MARK != u16Offset)
+      {
+        pstRing->u16Reserved = u16Size;
+        pstRing->u16ReservedOffset = u16Offset;
+        pvRetVal = _rtcos_ring_payload(pstRing, u16Offset);
+      }
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  return pvRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Publish the message written in the room given by rtcos_ring_reserve()
+  * @param      u08TaskID ID of the task which will receive the message
+  * @param      u16Size Actual size of the message in bytes, at most the reserved size,
+  *             0 cancels the reservation
+  * @return     Status as defined in ::rtcos_status_t, RTCOS_ERR_ARG if nothing is reserved or
+  *             if the size is above the reserved one
+  ********************************************************************************************** */
+rtcos_status_t rtcos_ring_commit(uint8_t u08TaskID, uint16_t u16Size)
+{
+  rtcos_ring_t *pstRing;
+  uint32_t u32Length;
+  rtcos_status_t eRetVal;
+
+  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
+  {
+    pstRing = &RTCOSi_stMain.tstTasks[u08TaskID].stRing;
+    u32Length = RTCOS_RING_HEADER_SIZE + RTCOS_RING_ALIGN(u16Size);
+    RTCOS_ENTER_CRITICAL_SECTION();
+    if((0 == pstRing->u16Reserved) || (u16Size > pstRing->u16Reserved))
+    {
+      eRetVal = RTCOS_ERR_ARG;
+    }
+    else
+    {
+      if(0 != u16Size)
+      {
+        if(pstRing->u16ReservedOffset != pstRing->u16Head)
+        {
+          /* The message wrapped, the end of the ring is skipped */
+          if((RTCOS_MESSAGE_RING_SIZE - pstRing->u16Head) >= RTCOS_RING_HEADER_SIZE)
+          {
+            *_rtcos_ring_header(pstRing, pstRing->u16Head) = RTCOS_RING_WRAP_MARK;
+          }
+          pstRing->u16Used += (uint16_t)(RTCOS_MESSAGE_RING_SIZE - pstRing->u16Head);
+        }
+        *_rtcos_ring_header(pstRing, pstRing->u16ReservedOffset) = u16Size;
+        pstRing->u16Head = (uint16_t)(pstRing->u16ReservedOffset + u32Length);
+        pstRing->u16Used += (uint16_t)u32Length;
+        RTCOS_TRACE(RTCOS_TRACE_MESSAGE_PUSH, u08TaskID,
+                    (uintptr_t)_rtcos_ring_payload(pstRing, pstRing->u16ReservedOffset));
+        _rtcos_set_task_ready(u08TaskID);
+      }
+      pstRing->u16Reserved = 0;
+      eRetVal = RTCOS_ERR_NONE;
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  else
+  {
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read the oldest message of the ring in place from inside a task handler,
+  *             it stays valid until rtcos_ring_release()
+  * @param      pu16Size This will hold the size of the message in bytes
+  * @return     Pointer to the message or NULL if the ring is empty
+  ********************************************************************************************** */
+void const *rtcos_ring_read(uint16_t *pu16Size)
+{
+  rtcos_ring_t *pstRing;
+  uint16_t u16Offset;
+  void const *pvRetVal;
+
+  pvRetVal = NULL;
+  if((NULL != pu16Size) && (RTCOS_CURRENT_TASK_ID < RTCOSi_stMain.u08TasksCount))
+  {
+    pstRing = &RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].stRing;
+    RTCOS_ENTER_CRITICAL_SECTION();
+    if(0 != pstRing->u16Used)
+    {
+      u16Offset = _rtcos_ring_oldest(pstRing);
+      *pu16Size = *_rtcos_ring_header(pstRing, u16Offset);
+      pvRetVal = _rtcos_ring_payload(pstRing, u16Offset);
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  return pvRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Free the oldest message of the ring from inside a task handler
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_ring_release(void)
+{
+  rtcos_ring_t *pstRing;
+  uint16_t u16Offset;
+  uint16_t u16Length;
+  rtcos_status_t eRetVal;
+
+  if(RTCOS_CURRENT_TASK_ID < RTCOSi_stMain.u08TasksCount)
+  {
+    pstRing = &RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].stRing;
+    RTCOS_ENTER_CRITICAL_SECTION();
+    if(0 != pstRing->u16Used)
+    {
+      u16Offset = _rtcos_ring_oldest(pstRing);
+      u16Length = *_rtcos_ring_header(pstRing, u16Offset);
+      u16Length = (uint16_t)(RTCOS_RING_HEADER_SIZE + RTCOS_RING_ALIGN(u16Length));
+      if(u16Offset != pstRing->u16Tail)
+      {
+        pstRing->u16Used -= (uint16_t)(RTCOS_MESSAGE_RING_SIZE - pstRing->u16Tail);
+      }
+      RTCOS_TRACE(RTCOS_TRACE_MESSAGE_POP, RTCOS_CURRENT_TASK_ID,
+                  (uintptr_t)_rtcos_ring_payload(pstRing, u16Offset));
+      pstRing->u16Tail = u16Offset + u16Length;
+      pstRing->u16Used -= u16Length;
+      eRetVal = RTCOS_ERR_NONE;
+    }
+    else
+    {
+      eRetVal = RTCOS_ERR_MSG_EMPTY;
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+#ifdef RTCOS_ENABLE_STATS
+    if(RTCOS_ERR_NONE == eRetVal)
+    {
+      ++RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].u32MessagesTaken;
+    }
+#endif /* RTCOS_ENABLE_STATS */
   }
   else
   {
-    RTCOSi_stMain.tstTimers[u08TimerID].bInUse = false;
-    eRetVal = RTCOS_ERR_NONE;
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_MESSAGE_RINGS */
+
+#ifdef RTCOS_ENABLE_MESSAGE_POOLS
+/** ***********************************************************************************************
+  * @brief      Allocate a message from the smallest pool that has a free block big enough,
+  *             in constant time. The caller owns the only reference: it fills the message, sends
+  *             or broadcasts it, which gives one reference to each receiver, then releases its
+  *             own. Each receiver releases the message once done with it.
+  * @param      u16Size Size of the message in bytes
+  * @return     Message pointer or NULL if no pool can hold it
+  ********************************************************************************************** */
+void *rtcos_msg_alloc(uint16_t u16Size)
+{
+  rtcos_msg_block_t *pstBlock;
+  uint8_t u08Pool;
+  void *pvRetVal;
+
+  pvRetVal = NULL;
+  pstBlock = NULL;
+  RTCOS_ENTER_CRITICAL_SECTION();
+  for(u08Pool = 0; (NULL == pstBlock) && (u08Pool < RTCOS_MSG_POOLS_COUNT); ++u08Pool)
+  {
+    if((u16Size <= RTCOSi_tstMsgPools[u08Pool].u16BlockSize) &&
+       (NULL != RTCOSi_stMain.tpstMsgFreeLists[u08Pool]))
+    {
+      pstBlock = RTCOSi_stMain.tpstMsgFreeLists[u08Pool];
+      RTCOSi_stMain.tpstMsgFreeLists[u08Pool] = pstBlock->pstNext;
+    }
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
+  if(NULL != pstBlock)
+  {
+#ifdef RTCOS_ENABLE_LOCKFREE_MESSAGES
+    atomic_store_explicit(&pstBlock->u16RefCount, 1, memory_order_relaxed);
+#else
+    pstBlock->u16RefCount = 1;
+#endif /* RTCOS_ENABLE_LOCKFREE_MESSAGES */
+    pvRetVal = (uint8_t *)pstBlock + RTCOS_MSG_HEADER_SIZE;
+  }
+  return pvRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Release a reference on a message allocated by rtcos_msg_alloc(), the message goes
+  *             back to its pool when the last reference is released
+  * @param      pvMsg Message pointer
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_msg_release(void *pvMsg)
+{
+  rtcos_msg_block_t *pstBlock;
+  rtcos_status_t eRetVal;
+
+  /* A message released twice is no longer the message of an allocated block */
+  eRetVal = _rtcos_msg_get_block(pvMsg, &pstBlock);
+  if(NULL != pstBlock)
+  {
+    eRetVal = _rtcos_msg_put_ref(pstBlock);
+  }
+  else if(RTCOS_ERR_NONE == eRetVal)
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_MESSAGE_POOLS */
+
+#ifdef RTCOS_ENABLE_TIMERS
+/** ***********************************************************************************************
+  * @brief      Create an os software timer, the slot is taken from the head of the free list
+  * @param      ePeriodType timer type as defined in ::rtcos_timer_type_t
+  * @param      pfTimerCb Timer callback function
+  * @param      pvArg Additional argument passed to the timer callback
+  * @return     Handle of the created timer or error
+  ********************************************************************************************** */
+rtcos_timer_id_t rtcos_create_timer(rtcos_timer_type_t ePeriodType,
+                                    pf_os_timer_cb_t pfTimerCb,
+                                    void *pvArg)
+{
+  rtcos_timer_id_t sRetVal;
+  uint8_t u08Index;
+
+  RTCOS_ENTER_CRITICAL_SECTION();
+  u08Index = RTCOSi_stMain.u08FreeTimers;
+  if(RTCOS_TIMER_NONE == u08Index)
+  {
+    sRetVal = RTCOS_ERR_OUT_OF_RESOURCES;
+  }
+  else
+  {
+    RTCOSi_stMain.u08FreeTimers = RTCOSi_stMain.tstTimers[u08Index].u08Next;
+    RTCOSi_stMain.tstTimers[u08Index].bCreated = true;
+    RTCOSi_stMain.tstTimers[u08Index].bInUse = false;
+    RTCOSi_stMain.tstTimers[u08Index].ePeriodType = ePeriodType;
+    RTCOSi_stMain.tstTimers[u08Index].pfTimerCb = pfTimerCb;
+    RTCOSi_stMain.tstTimers[u08Index].pvArg = pvArg;
+    RTCOSi_stMain.u08TimersCount++;
+    sRetVal = RTCOS_TIMER_HANDLE(u08Index);
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
+  return sRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Delete an os software timer, the timer is stopped and its slot goes back to the
+  *             free list. With RTCOS_ENABLE_TIMER_HANDLES the handle and every copy of it are no
+  *             longer valid, else the ID is the slot and it names the next timer created there
+  * @param      sTimerID Handle of the timer to delete
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_delete_timer(rtcos_timer_id_t sTimerID)
+{
+  rtcos_status_t eRetVal;
+  uint8_t u08Index;
+
+  RTCOS_ENTER_CRITICAL_SECTION();
+  eRetVal = _rtcos_timer_lookup(sTimerID, &u08Index);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+    _rtcos_wheel_remove(&RTCOSi_stMain.tstTimers[u08Index].stNode);
+#else
+    if(RTCOSi_stMain.tstTimers[u08Index].bInUse)
+    {
+      _rtcos_timer_unlink(u08Index);
+    }
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+    RTCOSi_stMain.tstTimers[u08Index].bInUse = false;
+    RTCOSi_stMain.tstTimers[u08Index].bCreated = false;
+    RTCOSi_stMain.tstTimers[u08Index].pfTimerCb = NULL;
+    RTCOSi_stMain.tstTimers[u08Index].pvArg = NULL;
+#ifdef RTCOS_ENABLE_TIMER_HANDLES
+    if(RTCOS_TIMER_GENERATION_MAX == RTCOSi_stMain.tstTimers[u08Index].u08Generation)
+    {
+      RTCOSi_stMain.tstTimers[u08Index].u08Generation = 1;
+    }
+    else
+    {
+      RTCOSi_stMain.tstTimers[u08Index].u08Generation++;
+    }
+#endif /* RTCOS_ENABLE_TIMER_HANDLES */
+    RTCOSi_stMain.tstTimers[u08Index].u08Next = RTCOSi_stMain.u08FreeTimers;
+    RTCOSi_stMain.u08FreeTimers = u08Index;
+    RTCOSi_stMain.u08TimersCount--;
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Start os software timer, a running timer is restarted
+  * @param      sTimerID Handle of the timer to start
+  * @param      u32PeriodInTicks Timer period in ticks
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_start_timer(rtcos_timer_id_t sTimerID, uint32_t u32PeriodInTicks)
+{
+  rtcos_status_t eRetVal;
+  uint8_t u08Index;
+
+  RTCOS_ENTER_CRITICAL_SECTION();
+  eRetVal = _rtcos_timer_lookup(sTimerID, &u08Index);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    RTCOSi_stMain.tstTimers[u08Index].u32TickDelay = u32PeriodInTicks;
+    RTCOSi_stMain.tstTimers[u08Index].u32StartTickCount = RTCOS_EXPIRY_TICKS_COUNT;
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+    RTCOSi_stMain.tstTimers[u08Index].u32StartDelay = RTCOS_PENDING_TICKS;
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+    /* Same expiry as the scan: the timer fires once more than u32PeriodInTicks have elapsed */
+    _rtcos_wheel_remove(&RTCOSi_stMain.tstTimers[u08Index].stNode);
+    RTCOSi_stMain.tstTimers[u08Index].stNode.u32ExpiryTick =
+      RTCOSi_stMain.u32WheelTick + RTCOS_PENDING_TICKS + u32PeriodInTicks + 1;
+    _rtcos_wheel_insert(&RTCOSi_stMain.tstTimers[u08Index].stNode);
+#else
+    if(!RTCOSi_stMain.tstTimers[u08Index].bInUse)
+    {
+      _rtcos_timer_link(u08Index);
+    }
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+    RTCOSi_stMain.tstTimers[u08Index].bInUse = true;
+  }
+  RTCOS_EXIT_CRITICAL_SECTION();
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Stop os software timer, the timer keeps its handle and can be started again
+  * @param      sTimerID Handle of the timer to stop
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_stop_timer(rtcos_timer_id_t sTimerID)
+{
+  rtcos_status_t eRetVal;
+  uint8_t u08Index;
+
+  RTCOS_ENTER_CRITICAL_SECTION();
+  eRetVal = _rtcos_timer_lookup(sTimerID, &u08Index);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+#ifdef RTCOS_ENABLE_TIMING_WHEEL
+    _rtcos_wheel_remove(&RTCOSi_stMain.tstTimers[u08Index].stNode);
+#else
+    if(RTCOSi_stMain.tstTimers[u08Index].bInUse)
+    {
+      _rtcos_timer_unlink(u08Index);
+    }
+#endif /* RTCOS_ENABLE_TIMING_WHEEL */
+    RTCOSi_stMain.tstTimers[u08Index].bInUse = false;
   }
   RTCOS_EXIT_CRITICAL_SECTION();
   return eRetVal;
@@ -666,21 +4424,23 @@ rtcos_status_t rtcos_stop_timer(uint8_t u08TimerID)
 
 /** ***********************************************************************************************
   * @brief      Check if the os software timer has expired
-  * @param      u08TimerID ID of the timer to check
+  * @param      sTimerID Handle of the timer to check
   * @return     true if timer has expired, else false
   ********************************************************************************************** */
-bool rtcos_timer_expired(uint8_t u08TimerID)
+bool rtcos_timer_expired(rtcos_timer_id_t sTimerID)
 {
   uint32_t u32CurrentTicksCount;
+  uint8_t u08Index;
   bool bExpired;
 
   bExpired = false;
-  u32CurrentTicksCount = RTCOSi_stMain.u32SysTicksCount;
   RTCOS_ENTER_CRITICAL_SECTION();
-  if((RTCOSi_stMain.tstTimers[u08TimerID].bInUse) && (u08TimerID < RTCOS_MAX_TIMERS_COUNT))
+  u32CurrentTicksCount = RTCOS_EXPIRY_TICKS_COUNT;
+  if((RTCOS_ERR_NONE == _rtcos_timer_lookup(sTimerID, &u08Index)) &&
+     (RTCOSi_stMain.tstTimers[u08Index].bInUse))
   {
-    if((u32CurrentTicksCount - RTCOSi_stMain.tstTimers[u08TimerID].u32StartTickCount) >
-       (RTCOSi_stMain.tstTimers[u08TimerID].u32TickDelay))
+    if((u32CurrentTicksCount - RTCOSi_stMain.tstTimers[u08Index].u32StartTickCount) >
+       RTCOS_TIMER_DELAY(&RTCOSi_stMain.tstTimers[u08Index]))
     {
       bExpired = true;
     }
@@ -710,9 +4470,20 @@ rtcos_status_t rtcos_send_event(uint8_t u08TaskID,
   {
     if(0 == u32EventDelay)
     {
+      RTCOS_TRACE(RTCOS_TRACE_EVENT_POST, u08TaskID, u32EventFlags);
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+      RTCOS_EVENT_COUNTS_POST(u08TaskID, u32EventFlags);
+      if(0 == RTCOS_TASK_EVENTS_SET(u08TaskID, u32EventFlags))
+      {
+        _rtcos_post_task_ready(u08TaskID);
+      }
+#else
       RTCOS_ENTER_CRITICAL_SECTION();
-      RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags |= u32EventFlags;
+      RTCOS_EVENT_COUNTS_POST(u08TaskID, u32EventFlags);
+      RTCOS_TASK_EVENTS_SET(u08TaskID, u32EventFlags);
+      _rtcos_set_task_ready(u08TaskID);
       RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
     }
     else
     {
@@ -729,7 +4500,9 @@ rtcos_status_t rtcos_send_event(uint8_t u08TaskID,
   * @param      bPeriodicEvent Indicates whether to send this event periodically or not
   * @return     RTCOS_ERR_NONE if everything is ok
   ********************************************************************************************** */
-rtcos_status_t rtcos_broadcast_event(uint32_t u32EventFlags, uint32_t u32EventDelay, bool bPeriodicEvent)
+rtcos_status_t rtcos_broadcast_event(uint32_t u32EventFlags,
+                                     uint32_t u32EventDelay,
+                                     bool bPeriodicEvent)
 {
   uint8_t u08Index;
   rtcos_status_t eRetVal;
@@ -737,33 +4510,305 @@ rtcos_status_t rtcos_broadcast_event(uint32_t u32EventFlags, uint32_t u32EventDe
   eRetVal = RTCOS_ERR_NONE;
   for(u08Index = 0; u08Index < RTCOSi_stMain.u08TasksCount; ++u08Index)
   {
-    eRetVal |= rtcos_send_event(u08Index, u32EventFlags, u32EventDelay, bPeriodicEvent);
+    if(RTCOS_TASK_EXISTS(u08Index))
+    {
+      eRetVal |= rtcos_send_event(u08Index, u32EventFlags, u32EventDelay, bPeriodicEvent);
+    }
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Clear an event for a certain task, the event might be in
+  *             the current event flags or in a future event.
+  *             This will clear them in both places.
+  * @param      u08TaskID ID of the task using the event
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_clear_event(uint8_t u08TaskID, uint32_t u32EventFlags)
+{
+  rtcos_status_t eRetVal;
+
+  eRetVal = _rtcos_check_event_input(u08TaskID, u32EventFlags);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    RTCOS_TASK_EVENTS_CLEAR(u08TaskID, u32EventFlags);
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+    _rtcos_event_counts_clear(u08TaskID, u32EventFlags);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+    _rtcos_update_task_ready(u08TaskID);
+    _rtcos_delete_future_event(u08TaskID, u32EventFlags); 
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  return eRetVal;
+}
+
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+/** ***********************************************************************************************
+  * @brief      Set an event for a certain task from an interrupt or another thread.
+  *             The flags are merged with an atomic fetch-or and interrupts are never masked.
+  * @param      u08TaskID ID of the task which will receive the event
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_send_event_from_isr(uint8_t u08TaskID, uint32_t u32EventFlags)
+{
+  rtcos_status_t eRetVal;
+
+  eRetVal = _rtcos_check_event_input(u08TaskID, u32EventFlags);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    RTCOS_TRACE(RTCOS_TRACE_EVENT_POST, u08TaskID, u32EventFlags);
+    RTCOS_EVENT_COUNTS_POST(u08TaskID, u32EventFlags);
+    /* Flags that were already pending mean an earlier post has flagged the task as ready */
+    if(0 == RTCOS_TASK_EVENTS_SET(u08TaskID, u32EventFlags))
+    {
+      _rtcos_post_task_ready(u08TaskID);
+    }
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Clear an event for a certain task from an interrupt or another thread.
+  *             Only the current event flags are cleared with an atomic fetch-and,
+  *             use rtcos_clear_event() to also remove the future events.
+  * @param      u08TaskID ID of the task using the event
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_clear_event_from_isr(uint8_t u08TaskID, uint32_t u32EventFlags)
+{
+  rtcos_status_t eRetVal;
+
+  eRetVal = _rtcos_check_event_input(u08TaskID, u32EventFlags);
+  if(RTCOS_ERR_NONE == eRetVal)
+  {
+    RTCOS_TASK_EVENTS_CLEAR(u08TaskID, u32EventFlags);
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+    _rtcos_event_counts_clear(u08TaskID, u32EventFlags);
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+  }
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+
+#ifdef RTCOS_ENABLE_EVENT_COUNTS
+/** ***********************************************************************************************
+  * @brief      Select the events of a task whose posts are counted, posts of these events made
+  *             before the task runs are no longer merged into a single flag.
+  *             The pending counts of the events leaving the selection are dropped
+  * @param      u08TaskID ID of the task receiving the events
+  * @param      u32EventMask Event flags to count
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_set_counted_events(uint8_t u08TaskID, uint32_t u32EventMask)
+{
+  rtcos_status_t eRetVal;
+
+  if(u08TaskID >= RTCOSi_stMain.u08TasksCount)
+  {
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+  else
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    RTCOSi_stMain.tstTasks[u08TaskID].u32CountedEvents = u32EventMask;
+    _rtcos_event_counts_clear(u08TaskID, ~u32EventMask);
+    RTCOS_EXIT_CRITICAL_SECTION();
+    eRetVal = RTCOS_ERR_NONE;
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get how many times an event was posted for the running handler call, to be called
+  *             from a task handler. A counted event saturates at 255 posts, an event that is not
+  *             counted reads 1 when it was given to the handler.
+  *             With RTCOS_ENABLE_ISR_EVENTS a post racing with the dispatch may be counted by the
+  *             previous call, its flag then reads 0 posts but no post is ever lost
+  * @param      u32EventFlag Single event flag
+  * @return     Number of posts, 0 if the event was not given to the handler
+  ********************************************************************************************** */
+uint8_t rtcos_get_event_count(uint32_t u32EventFlag)
+{
+  uint8_t u08Count;
+  uint8_t u08Event;
+
+  u08Count = 0;
+  if((RTCOS_CURRENT_TASK_ID < RTCOSi_stMain.u08TasksCount) && (0 != u32EventFlag) &&
+     (0 == (u32EventFlag & (u32EventFlag - 1))) &&
+     (0 != (RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].u32RunEvents & u32EventFlag)))
+  {
+    if(0 == (RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].u32CountedEvents & u32EventFlag))
+    {
+      u08Count = 1;
+    }
+    else
+    {
+      u08Event = (uint8_t)(31 - _rtcos_clz(u32EventFlag));
+      u08Count = RTCOSi_stMain.tstTasks[RTCOS_CURRENT_TASK_ID].tu08RunCounts[u08Event];
+    }
+  }
+  return u08Count;
+}
+#endif /* RTCOS_ENABLE_EVENT_COUNTS */
+
+#ifdef RTCOS_ENABLE_STATS
+/** ***********************************************************************************************
+  * @brief      Read the runtime statistics of a task without taking the critical section,
+  *             the copy is retried if the scheduler updates the statistics meanwhile.
+  *             Must not be called from an interrupt that can preempt the scheduler.
+  * @param      u08TaskID ID of the task
+  * @param      pstStats This will hold a consistent copy of the task statistics
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_get_task_stats(uint8_t u08TaskID, rtcos_task_stats_t *pstStats)
+{
+  rtcos_task_t *pstTask;
+  uint32_t u32Sequence;
+  rtcos_status_t eRetVal;
+
+  eRetVal = RTCOS_ERR_NONE;
+  if(NULL == pstStats)
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  else if(u08TaskID >= RTCOSi_stMain.u08TasksCount)
+  {
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+  else
+  {
+    pstTask = &RTCOSi_stMain.tstTasks[u08TaskID];
+    do
+    {
+      u32Sequence = atomic_load_explicit(&pstTask->u32StatsSequence, memory_order_acquire);
+      *pstStats = pstTask->stStats;
+      atomic_thread_fence(memory_order_acquire);
+    }while((0 != (u32Sequence & 1)) ||
+           (u32Sequence != atomic_load_explicit(&pstTask->u32StatsSequence, memory_order_relaxed)));
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the share of time the scheduler spent running tasks and processing ticks
+  *             since rtcos_run() was called, the rest is idle time. Lock-free like
+  *             rtcos_get_task_stats().
+  * @return     CPU load in percent
+  ********************************************************************************************** */
+uint8_t rtcos_get_cpu_load(void)
+{
+  rtcos_loop_time_t *pstLoop;
+  uint64_t u64BusyTime;
+  uint64_t u64TotalTime;
+  uint64_t u64LoopBusyTime;
+  uint64_t u64LoopIdleTime;
+  uint32_t u32Sequence;
+  uint8_t u08Loop;
+
+  u64BusyTime = 0;
+  u64TotalTime = 0;
+  for(u08Loop = 0; u08Loop < RTCOS_STATS_LOOPS_COUNT; ++u08Loop)
+  {
+    pstLoop = &RTCOSi_stMain.tstLoopTimes[u08Loop];
+    do
+    {
+      u32Sequence = atomic_load_explicit(&pstLoop->u32Sequence, memory_order_acquire);
+      u64LoopBusyTime = pstLoop->u64BusyTime;
+      u64LoopIdleTime = pstLoop->u64IdleTime;
+      atomic_thread_fence(memory_order_acquire);
+    }while((0 != (u32Sequence & 1)) ||
+           (u32Sequence != atomic_load_explicit(&pstLoop->u32Sequence, memory_order_relaxed)));
+    u64BusyTime += u64LoopBusyTime;
+    u64TotalTime += u64LoopBusyTime + u64LoopIdleTime;
+  }
+  return (0 == u64TotalTime) ? 0 : (uint8_t)((u64BusyTime * 100) / u64TotalTime);
+}
+#endif /* RTCOS_ENABLE_STATS */
+
+#ifdef RTCOS_ENABLE_TASK_BUDGETS
+/** ***********************************************************************************************
+  * @brief      Set the execution budget of the handler calls of a task, longer calls are counted
+  *             as overruns and reported to RTCOS_PORT_BUDGET_OVERRUN()
+  * @param      u08TaskID ID of the task
+  * @param      u32Budget Budget in RTCOS_PORT_TIMESTAMP() units, 0 disables the check
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_set_task_budget(uint8_t u08TaskID, uint32_t u32Budget)
+{
+  rtcos_status_t eRetVal;
+
+  eRetVal = RTCOS_ERR_INVALID_TASK;
+  if(u08TaskID < RTCOSi_stMain.u08TasksCount)
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    RTCOSi_stMain.tstTasks[u08TaskID].stOverruns.u32Budget = u32Budget;
+    RTCOS_EXIT_CRITICAL_SECTION();
+    eRetVal = RTCOS_ERR_NONE;
   }
   return eRetVal;
 }
 
 /** ***********************************************************************************************
-  * @brief      Clear an event for a certain task, the event might be in
-  *             the current event flags or in a future event.
-  *             This will clear them in both places.
-  * @param      u08TaskID ID of the task using the event
-  * @param      u32EventFlags Bit feild event
+  * @brief      Get the budget of a task with the number of overruns and the last one
+  * @param      u08TaskID ID of the task
+  * @param      pstOverruns This will hold a copy of the task overruns
   * @return     Status as defined in ::rtcos_status_t
   ********************************************************************************************** */
-rtcos_status_t rtcos_clear_event(uint8_t u08TaskID, uint32_t u32EventFlags)
+rtcos_status_t rtcos_get_task_overruns(uint8_t u08TaskID, rtcos_task_overruns_t *pstOverruns)
 {
   rtcos_status_t eRetVal;
 
-  eRetVal = _rtcos_check_event_input(u08TaskID, u32EventFlags);
-  if(RTCOS_ERR_NONE == eRetVal)
+  eRetVal = RTCOS_ERR_NONE;
+  if(NULL == pstOverruns)
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  else if(u08TaskID >= RTCOSi_stMain.u08TasksCount)
+  {
+    eRetVal = RTCOS_ERR_INVALID_TASK;
+  }
+  else
   {
     RTCOS_ENTER_CRITICAL_SECTION();
-    RTCOSi_stMain.tstTasks[u08TaskID].u32EventFlags &= ~(u32EventFlags);
-    _rtcos_delete_future_event(u08TaskID, u32EventFlags); 
+    *pstOverruns = RTCOSi_stMain.tstTasks[u08TaskID].stOverruns;
     RTCOS_EXIT_CRITICAL_SECTION();
   }
   return eRetVal;
 }
+#endif /* RTCOS_ENABLE_TASK_BUDGETS */
+
+#ifdef RTCOS_ENABLE_TRACE
+/** ***********************************************************************************************
+  * @brief      Start or stop recording, e.g. stop it as soon as a latency spike is detected
+  *             so that the records leading to it are not overwritten before the dump
+  * @param      bEnabled true to record, false to freeze the trace ring buffer
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_enable_trace(bool bEnabled)
+{
+  atomic_store_explicit(&RTCOSi_stMain.bTraceEnabled, bEnabled, memory_order_relaxed);
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the trace ring buffer to dump it, as is, to a file, a serial link or through
+  *             a debugger. tools/trace decodes the dump.
+  * @param      pu32Size This will hold the size of the buffer in bytes
+  * @return     Address of the trace ring buffer
+  ********************************************************************************************** */
+void const *rtcos_get_trace_buffer(uint32_t *pu32Size)
+{
+  if(pu32Size)
+  {
+    *pu32Size = (uint32_t)sizeof(RTCOSi_stTrace);
+  }
+  return &RTCOSi_stTrace;
+}
+#endif /* RTCOS_ENABLE_TRACE */
 
 /** ***********************************************************************************************
   * @brief      Set the current tick count that is kept by the system.
@@ -773,7 +4818,18 @@ rtcos_status_t rtcos_clear_event(uint8_t u08TaskID, uint32_t u32EventFlags)
   ********************************************************************************************** */
 void rtcos_set_tick_count(uint32_t u32TickCount)
 {
+  RTCOS_ENTER_CRITICAL_SECTION();
+#ifdef RTCOS_ENABLE_TIME64
+  _rtcos_seq_write_begin(&RTCOSi_stMain.u32TimeSequence);
+  RTCOSi_stMain.u32SysTicksCount = u32TickCount;
+  _rtcos_seq_write_end(&RTCOSi_stMain.u32TimeSequence);
+#else
   RTCOSi_stMain.u32SysTicksCount = u32TickCount;
+#endif /* RTCOS_ENABLE_TIME64 */
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+  RTCOSi_stMain.u32ProcessedTicksCount = u32TickCount;
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+  RTCOS_EXIT_CRITICAL_SECTION();
 }
 
 /** ***********************************************************************************************
@@ -784,12 +4840,83 @@ uint32_t rtcos_get_tick_count(void)
 {
   uint32_t u32CurrTickCount;
 
+#ifdef RTCOS_ENABLE_TIME64
+  u32CurrTickCount = (uint32_t)rtcos_get_tick_count64();
+#else
   RTCOS_ENTER_CRITICAL_SECTION();
   u32CurrTickCount = RTCOSi_stMain.u32SysTicksCount;
   RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_TIME64 */
   return u32CurrTickCount;
 }
 
+/** ***********************************************************************************************
+  * @brief      Get the task whose handler is running on the calling context, only meaningful
+  *             from inside a task handler
+  * @return     ID of the running task
+  ********************************************************************************************** */
+uint8_t rtcos_get_current_task(void)
+{
+  return RTCOS_CURRENT_TASK_ID;
+}
+
+#ifdef RTCOS_ENABLE_TIME64
+/** ***********************************************************************************************
+  * @brief      Get the 64 bits tick count without masking interrupts, the read is retried if a
+  *             tick is counted meanwhile. Must not be called from an interrupt that can preempt
+  *             rtcos_update_tick() or rtcos_advance_ticks().
+  * @return     Number of ticks since rtcos_init(), it never wraps
+  ********************************************************************************************** */
+uint64_t rtcos_get_tick_count64(void)
+{
+  uint32_t u32Sequence;
+  uint32_t u32High;
+  uint32_t u32Low;
+
+  do
+  {
+    u32Sequence = atomic_load_explicit(&RTCOSi_stMain.u32TimeSequence, memory_order_acquire);
+    u32High = RTCOSi_stMain.u32SysTicksHigh;
+    u32Low = RTCOSi_stMain.u32SysTicksCount;
+    atomic_thread_fence(memory_order_acquire);
+  }while((0 != (u32Sequence & 1)) ||
+         (u32Sequence != atomic_load_explicit(&RTCOSi_stMain.u32TimeSequence,
+                                              memory_order_relaxed)));
+  return ((uint64_t)u32High << 32) | u32Low;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get a timestamp finer than a tick: the 64 bits tick count scaled by
+  *             RTCOS_SUBTICKS_PER_TICK plus RTCOS_PORT_SUBTICK(), read together without masking
+  *             interrupts. Same calling restrictions as rtcos_get_tick_count64().
+  * @return     Time since rtcos_init() in sub-tick units
+  ********************************************************************************************** */
+uint64_t rtcos_get_timestamp(void)
+{
+  uint32_t u32Sequence;
+  uint32_t u32High;
+  uint32_t u32Low;
+  uint32_t u32SubTick;
+
+  do
+  {
+    u32Sequence = atomic_load_explicit(&RTCOSi_stMain.u32TimeSequence, memory_order_acquire);
+    u32High = RTCOSi_stMain.u32SysTicksHigh;
+    u32Low = RTCOSi_stMain.u32SysTicksCount;
+    u32SubTick = (uint32_t)RTCOS_PORT_SUBTICK();
+    atomic_thread_fence(memory_order_acquire);
+  }while((0 != (u32Sequence & 1)) ||
+         (u32Sequence != atomic_load_explicit(&RTCOSi_stMain.u32TimeSequence,
+                                              memory_order_relaxed)));
+  /* A sub-tick counter running past the period before the tick is counted stays in its tick */
+  if(u32SubTick >= RTCOS_SUBTICKS_PER_TICK)
+  {
+    u32SubTick = RTCOS_SUBTICKS_PER_TICK - 1;
+  }
+  return ((((uint64_t)u32High << 32) | u32Low) * RTCOS_SUBTICKS_PER_TICK) + u32SubTick;
+}
+#endif /* RTCOS_ENABLE_TIME64 */
+
 /** ***********************************************************************************************
   * @brief      Blocking delay
   * @param      u32DelayTicksCount Number of ticks to wait before unblocking
@@ -800,98 +4927,467 @@ void rtcos_delay(uint32_t u32DelayTicksCount)
   uint32_t u32Tick;
 
   u32Tick = rtcos_get_tick_count();
-  while((rtcos_get_tick_count() - u32Tick) != u32DelayTicksCount);
+  /* The elapsed ticks are compared with < so that a tick counted late cannot be skipped */
+  while((rtcos_get_tick_count() - u32Tick) < u32DelayTicksCount);
 }
 
 /** ***********************************************************************************************
   * @brief      Find the highest priority task with some event.
   *             If found, call the task with the events.
   *             If no events or future events are in the system then the idle handler is called.
+  *             With RTCOS_ENABLE_WORKERS it starts the worker threads and the calling thread
+  *             becomes the first worker.
   * @return     Nothing
   ********************************************************************************************** */
 void rtcos_run(void)
 {
+#ifdef RTCOS_ENABLE_WORKERS
+  uint8_t u08WorkerID;
+
+  for(u08WorkerID = 1; u08WorkerID < RTCOS_WORKERS_COUNT; ++u08WorkerID)
+  {
+#ifdef RTCOS_ENABLE_INSTANCES
+    RTCOSi_stMain.tstWorkers[u08WorkerID].pstMain = RTCOSi_pstMain;
+    pthread_create(&RTCOSi_stMain.tstWorkers[u08WorkerID].stThread, NULL,
+                   _rtcos_worker_thread, &RTCOSi_stMain.tstWorkers[u08WorkerID]);
+#else
+    pthread_create(&RTCOSi_stMain.tstWorkers[u08WorkerID].stThread, NULL,
+                   _rtcos_worker_thread, (void *)(uintptr_t)u08WorkerID);
+#endif /* RTCOS_ENABLE_INSTANCES */
+  }
+  _rtcos_worker_loop(0);
+#else
   bool bFoundReadyTask;
   uint8_t u08ReadyTaskID;
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+  bool bTicksPending;
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+#ifdef RTCOS_ENABLE_STATS
+  uint32_t u32PassTime;
+#endif /* RTCOS_ENABLE_STATS */
 
+  u08ReadyTaskID = 0;
+#ifdef RTCOS_ENABLE_STATS
+  u32PassTime = (uint32_t)RTCOS_PORT_TIMESTAMP();
+#endif /* RTCOS_ENABLE_STATS */
   while(1)
   {
     /* Search for a task that received an event or message */
     RTCOS_ENTER_CRITICAL_SECTION();
+#ifdef RTCOS_ENABLE_PENDING_READY_MAP
+    _rtcos_collect_pending_ready();
+#endif /* RTCOS_ENABLE_PENDING_READY_MAP */
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+    _rtcos_age_ready_tasks();
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
     bFoundReadyTask = _rtcos_find_ready_task(&u08ReadyTaskID);
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+    bTicksPending = (RTCOSi_stMain.u32SysTicksCount != RTCOSi_stMain.u32ProcessedTicksCount);
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
     RTCOS_EXIT_CRITICAL_SECTION();
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+    /* The timer service runs before any ready task whose priority is not above its own */
+    if((true == bTicksPending)
+#if (RTCOS_TIMER_SERVICE_PRIORITY > 0)
+       && ((false == bFoundReadyTask) ||
+           (RTCOS_TASK_PRIORITY(u08ReadyTaskID) >= RTCOS_TIMER_SERVICE_PRIORITY))
+#endif /* RTCOS_TIMER_SERVICE_PRIORITY */
+      )
+    {
+      _rtcos_service_ticks();
+    }
+    else
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
     /* If found run the task */
     if(true == bFoundReadyTask)
     {
+#ifdef RTCOS_ENABLE_FAIR_SCHEDULING
+      RTCOS_ENTER_CRITICAL_SECTION();
+      _rtcos_fair_dispatch(u08ReadyTaskID);
+      RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_FAIR_SCHEDULING */
+#ifdef RTCOS_ENABLE_EDF_SCHEDULING
+      RTCOS_ENTER_CRITICAL_SECTION();
+      _rtcos_edf_dispatch(u08ReadyTaskID);
+      RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_EDF_SCHEDULING */
       _rtcos_run_ready_task(u08ReadyTaskID);
     }
+#ifdef RTCOS_ENABLE_TICKLESS
+    /* Else program a wakeup for the next deadline and let the IDLE handler sleep until then */
+    else if(NULL != RTCOSi_stMain.pfIdleHandler)
+    {
+      RTCOS_PORT_SET_WAKEUP(rtcos_get_ticks_to_next_deadline());
+      RTCOS_TRACE(RTCOS_TRACE_IDLE_ENTER, RTCOS_TRACE_NO_TASK, 0);
+      (RTCOSi_stMain.pfIdleHandler)();
+      RTCOS_TRACE(RTCOS_TRACE_IDLE_EXIT, RTCOS_TRACE_NO_TASK, 0);
+    }
+#else
     /* Else run the IDLE handler */
     else if((NULL != RTCOSi_stMain.pfIdleHandler) &&
-            (0 == RTCOSi_stMain.u08FutureEventsCount))
+            (0 == RTCOSi_stMain.u16FutureEventsCount))
     {
+      RTCOS_TRACE(RTCOS_TRACE_IDLE_ENTER, RTCOS_TRACE_NO_TASK, 0);
       (RTCOSi_stMain.pfIdleHandler)();
+      RTCOS_TRACE(RTCOS_TRACE_IDLE_EXIT, RTCOS_TRACE_NO_TASK, 0);
     }
+#endif /* RTCOS_ENABLE_TICKLESS */
+#ifdef RTCOS_ENABLE_STATS
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+    _rtcos_stats_record_pass(0, (true == bFoundReadyTask) || (true == bTicksPending), &u32PassTime);
+#else
+    _rtcos_stats_record_pass(0, bFoundReadyTask, &u32PassTime);
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+#endif /* RTCOS_ENABLE_STATS */
   }
+#endif /* RTCOS_ENABLE_WORKERS */
 }
 
 /** ***********************************************************************************************
   * @brief      This function should be called every time a tick occurs in the system.
   *             A tick is system dependent and is the measuring point
   *             for the delay of sending events.
+  *             With RTCOS_ENABLE_DEFERRED_TICK it only counts the tick, the expiries are
+  *             processed later from rtcos_run().
   * @return     Nothing
   ********************************************************************************************** */
 void rtcos_update_tick(void)
 {
-  uint8_t u08Index;
-  
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
+  _rtcos_add_ticks(1);
+#else
+  RTCOS_ENTER_CRITICAL_SECTION();
+  _rtcos_add_ticks(1);
+  _rtcos_process_tick();
+  RTCOS_EXIT_CRITICAL_SECTION();
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+}
+
+#ifdef RTCOS_ENABLE_TICKLESS
+/** ***********************************************************************************************
+  * @brief      Get the number of ticks until the earliest future event or timer expiry.
+  *             A tickless port can sleep that long before calling rtcos_advance_ticks().
+  * @return     Number of ticks or RTCOS_NO_DEADLINE if nothing is scheduled
+  ********************************************************************************************** */
+uint32_t rtcos_get_ticks_to_next_deadline(void)
+{
+  uint32_t u32Ticks;
+
+  RTCOS_ENTER_CRITICAL_SECTION();
+  u32Ticks = _rtcos_ticks_to_next_deadline();
+  RTCOS_EXIT_CRITICAL_SECTION();
+  return u32Ticks;
+}
+
+/** ***********************************************************************************************
+  * @brief      Catch up several ticks at once, e.g. after waking up from a tickless sleep.
+  *             Events and timers are delivered on the same ticks as if rtcos_update_tick()
+  *             had been called u32TicksCount times, but ticks on which nothing expires are
+  *             skipped in one go. Interrupts are unmasked between two expiry batches.
+  *             With RTCOS_ENABLE_DEFERRED_TICK the ticks are only counted here.
+  * @param      u32TicksCount Number of elapsed ticks
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_advance_ticks(uint32_t u32TicksCount)
+{
+#ifdef RTCOS_ENABLE_DEFERRED_TICK
   RTCOS_ENTER_CRITICAL_SECTION();
-  ++RTCOSi_stMain.u32SysTicksCount;
-  for(u08Index = 0; u08Index < RTCOS_MAX_FUTURE_EVENTS_COUNT; ++u08Index)
+  _rtcos_add_ticks(u32TicksCount);
+  RTCOS_EXIT_CRITICAL_SECTION();
+#else
+  while(u32TicksCount > 0)
   {
-    if(true == RTCOSi_stMain.tstFutureEvents[u08Index].bInUse)
+    RTCOS_ENTER_CRITICAL_SECTION();
+    u32TicksCount -= _rtcos_skip_ticks(u32TicksCount);
+    if(u32TicksCount > 0)
     {
-      --RTCOSi_stMain.tstFutureEvents[u08Index].u32EventDelay; 
-      if(0 == RTCOSi_stMain.tstFutureEvents[u08Index].u32EventDelay)
-      {
-        if(RTCOSi_stMain.u08FutureEventsCount > 0)
-        {
-          RTCOSi_stMain.u08FutureEventsCount--;
-        }
-        RTCOSi_stMain
-          .tstTasks[RTCOSi_stMain.tstFutureEvents[u08Index].u08TaskID]
-            .u32EventFlags |= RTCOSi_stMain.tstFutureEvents[u08Index].u32EventFlags;
-        if(0 == RTCOSi_stMain.tstFutureEvents[u08Index].u32ReloadDelay)
-        {
-          RTCOSi_stMain.tstFutureEvents[u08Index].bInUse = false;
-        }
-        else
-        {
-          RTCOSi_stMain
-            .tstFutureEvents[u08Index]
-              .u32EventDelay = RTCOSi_stMain.tstFutureEvents[u08Index].u32ReloadDelay;
-        }
-      }
+      _rtcos_add_ticks(1);
+      _rtcos_process_tick();
+      --u32TicksCount;
     }
+    RTCOS_EXIT_CRITICAL_SECTION();
   }
-#ifdef RTCOS_ENABLE_TIMERS
-  if(RTCOSi_stMain.u08TimersCount > 0)
+#endif /* RTCOS_ENABLE_DEFERRED_TICK */
+}
+#endif /* RTCOS_ENABLE_TICKLESS */
+
+#ifdef RTCOS_ENABLE_INSTANCES
+/** ***********************************************************************************************
+  * @brief      Take a free scheduler instance out of the RTCOS_MAX_INSTANCES_COUNT ones and
+  *             initialize it, the default instance is never returned. Instances given back with
+  *             rtcos_destroy() are handed out again
+  * @return     The new instance or NULL if they are all used
+  ********************************************************************************************** */
+rtcos_t *rtcos_create(void)
+{
+  rtcos_main_t *pstInstance;
+  rtcos_main_t *pstPrevious;
+  uint8_t u08Index;
+
+  pstInstance = NULL;
+  RTCOS_ENTER_CRITICAL_SECTION();
+  for(u08Index = 1; (NULL == pstInstance) && (u08Index < RTCOS_MAX_INSTANCES_COUNT); ++u08Index)
   {
-    for(u08Index = 0; u08Index < RTCOSi_stMain.u08TimersCount; u08Index++)
+    if(false == RTCOSi_tbInstancesUsed[u08Index])
     {
-      if(rtcos_timer_expired(u08Index))
-      {
-        if(RTCOSi_stMain.tstTimers[u08Index].pfTimerCb)
-        {
-          RTCOSi_stMain.tstTimers[u08Index].pfTimerCb(RTCOSi_stMain.tstTimers[u08Index].pvArg);
-        }
-        if(RTCOS_TIMER_ONE_SHOT == RTCOSi_stMain.tstTimers[u08Index].ePeriodType)
-        {
-          RTCOSi_stMain.tstTimers[u08Index].bInUse = false;
-        }
-        RTCOSi_stMain.tstTimers[u08Index].u32StartTickCount = RTCOSi_stMain.u32SysTicksCount;
-      }
+      RTCOSi_tbInstancesUsed[u08Index] = true;
+      pstInstance = &RTCOSi_tstInstances[u08Index];
     }
   }
-#endif /* RTCOS_ENABLE_TIMERS */
   RTCOS_EXIT_CRITICAL_SECTION();
+  if(NULL != pstInstance)
+  {
+    pstPrevious = RTCOSi_pstMain;
+    RTCOSi_pstMain = pstInstance;
+    rtcos_init();
+    RTCOSi_pstMain = pstPrevious;
+  }
+  return pstInstance;
+}
+
+/** ***********************************************************************************************
+  * @brief      Give an instance back so that rtcos_create() can hand it out again. The instance
+  *             must no longer run: no thread, worker, timer or interrupt may use it afterwards
+  * @param      pstOs Instance returned by rtcos_create()
+  * @return     Status as defined in ::rtcos_status_t, RTCOS_ERR_ARG for the default instance or
+  *             an instance that is not in use, RTCOS_ERR_IN_USE if the calling thread is bound
+  *             to it
+  ********************************************************************************************** */
+rtcos_status_t rtcos_destroy(rtcos_t *pstOs)
+{
+  uintptr_t uIndex;
+  rtcos_status_t eRetVal;
+
+  uIndex = ((uintptr_t)pstOs - (uintptr_t)&RTCOSi_tstInstances[0]) / sizeof(rtcos_main_t);
+  if((NULL == pstOs) || (0 == uIndex) || (uIndex >= RTCOS_MAX_INSTANCES_COUNT) ||
+     (pstOs != &RTCOSi_tstInstances[uIndex]))
+  {
+    eRetVal = RTCOS_ERR_ARG;
+  }
+  else if(pstOs == RTCOSi_pstMain)
+  {
+    eRetVal = RTCOS_ERR_IN_USE;
+  }
+  else
+  {
+    RTCOS_ENTER_CRITICAL_SECTION();
+    if(true == RTCOSi_tbInstancesUsed[uIndex])
+    {
+      RTCOSi_tbInstancesUsed[uIndex] = false;
+      eRetVal = RTCOS_ERR_NONE;
+    }
+    else
+    {
+      eRetVal = RTCOS_ERR_ARG;
+    }
+    RTCOS_EXIT_CRITICAL_SECTION();
+  }
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the default instance, the one used by the threads that never bound another
+  * @return     The default instance
+  ********************************************************************************************** */
+rtcos_t *rtcos_get_default(void)
+{
+  return &RTCOSi_tstInstances[0];
+}
+
+/** ***********************************************************************************************
+  * @brief      Make the calling thread operate on an instance: every rtcos_* call made by this
+  *             thread afterwards acts on it. Task handlers and workers always run bound to their
+  *             own instance
+  * @param      pstOs Instance to use, NULL for the default instance
+  * @return     The instance the thread was bound to
+  ********************************************************************************************** */
+rtcos_t *rtcos_bind(rtcos_t *pstOs)
+{
+  rtcos_main_t *pstPrevious;
+
+  pstPrevious = RTCOSi_pstMain;
+  RTCOSi_pstMain = (NULL != pstOs) ? pstOs : &RTCOSi_tstInstances[0];
+  return pstPrevious;
+}
+
+/** ***********************************************************************************************
+  * @brief      Initialize an instance, see rtcos_init()
+  * @param      pstOs Instance to initialize
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_init_r(rtcos_t *pstOs)
+{
+  rtcos_main_t *pstPrevious;
+
+  pstPrevious = rtcos_bind(pstOs);
+  rtcos_init();
+  RTCOSi_pstMain = pstPrevious;
+}
+
+/** ***********************************************************************************************
+  * @brief      Run an instance on the calling thread, which stays bound to it, see rtcos_run()
+  * @param      pstOs Instance to run
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_run_r(rtcos_t *pstOs)
+{
+  rtcos_bind(pstOs);
+  rtcos_run();
+}
+
+/** ***********************************************************************************************
+  * @brief      Give a tick to an instance, see rtcos_update_tick()
+  * @param      pstOs Instance receiving the tick
+  * @return     Nothing
+  ********************************************************************************************** */
+void rtcos_update_tick_r(rtcos_t *pstOs)
+{
+  rtcos_main_t *pstPrevious;
+
+  pstPrevious = rtcos_bind(pstOs);
+  rtcos_update_tick();
+  RTCOSi_pstMain = pstPrevious;
+}
+
+/** ***********************************************************************************************
+  * @brief      Get the tick count of an instance, see rtcos_get_tick_count()
+  * @param      pstOs Instance to read
+  * @return     Tick count of the instance
+  ********************************************************************************************** */
+uint32_t rtcos_get_tick_count_r(rtcos_t *pstOs)
+{
+  rtcos_main_t *pstPrevious;
+  uint32_t u32RetVal;
+
+  pstPrevious = rtcos_bind(pstOs);
+  u32RetVal = rtcos_get_tick_count();
+  RTCOSi_pstMain = pstPrevious;
+  return u32RetVal;
+}
+
+#ifndef RTCOS_ENABLE_STATIC_TASKS
+/** ***********************************************************************************************
+  * @brief      Register a task handler of an instance, see rtcos_register_task_handler()
+  * @param      pstOs Instance of the task
+  * @param      pfTaskHandler task handler function
+  * @param      u08TaskID ID of this task
+  * @param      pvArg Task argument
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_register_task_handler_r(rtcos_t *pstOs,
+                                             pf_os_task_handler_t pfTaskHandler,
+                                             uint8_t u08TaskID,
+                                             void *pvArg)
+{
+  rtcos_main_t *pstPrevious;
+  rtcos_status_t eRetVal;
+
+  pstPrevious = rtcos_bind(pstOs);
+  eRetVal = rtcos_register_task_handler(pfTaskHandler, u08TaskID, pvArg);
+  RTCOSi_pstMain = pstPrevious;
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_STATIC_TASKS */
+
+/** ***********************************************************************************************
+  * @brief      Register the idle handler of an instance, see rtcos_register_idle_handler()
+  * @param      pstOs Instance of the idle handler
+  * @param      pfIdleHandler idle handler function
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_register_idle_handler_r(rtcos_t *pstOs, pf_os_idle_handler_t pfIdleHandler)
+{
+  rtcos_main_t *pstPrevious;
+  rtcos_status_t eRetVal;
+
+  pstPrevious = rtcos_bind(pstOs);
+  eRetVal = rtcos_register_idle_handler(pfIdleHandler);
+  RTCOSi_pstMain = pstPrevious;
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Set an event for a task of an instance, see rtcos_send_event()
+  * @param      pstOs Instance of the task
+  * @param      u08TaskID ID of the task which will receive the event
+  * @param      u32EventFlags Bit feild event
+  * @param      u32EventDelay How long to wait before sending event, if 0 send immediately
+  * @param      bPeriodicEvent Indicates whether to send this event periodically or not
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_send_event_r(rtcos_t *pstOs,
+                                  uint8_t u08TaskID,
+                                  uint32_t u32EventFlags,
+                                  uint32_t u32EventDelay,
+                                  bool bPeriodicEvent)
+{
+  rtcos_main_t *pstPrevious;
+  rtcos_status_t eRetVal;
+
+  pstPrevious = rtcos_bind(pstOs);
+  eRetVal = rtcos_send_event(u08TaskID, u32EventFlags, u32EventDelay, bPeriodicEvent);
+  RTCOSi_pstMain = pstPrevious;
+  return eRetVal;
+}
+
+/** ***********************************************************************************************
+  * @brief      Clear an event of a task of an instance, see rtcos_clear_event()
+  * @param      pstOs Instance of the task
+  * @param      u08TaskID ID of the task using the event
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_clear_event_r(rtcos_t *pstOs, uint8_t u08TaskID, uint32_t u32EventFlags)
+{
+  rtcos_main_t *pstPrevious;
+  rtcos_status_t eRetVal;
+
+  pstPrevious = rtcos_bind(pstOs);
+  eRetVal = rtcos_clear_event(u08TaskID, u32EventFlags);
+  RTCOSi_pstMain = pstPrevious;
+  return eRetVal;
+}
+
+#ifdef RTCOS_ENABLE_MESSAGES
+/** ***********************************************************************************************
+  * @brief      Send a message to a task of an instance, see rtcos_send_message()
+  * @param      pstOs Instance of the task
+  * @param      u08TaskID ID of the task which will receive the message
+  * @param      pvMsg Message to send
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_send_message_r(rtcos_t *pstOs, uint8_t u08TaskID, void *pvMsg)
+{
+  rtcos_main_t *pstPrevious;
+  rtcos_status_t eRetVal;
+
+  pstPrevious = rtcos_bind(pstOs);
+  eRetVal = rtcos_send_message(u08TaskID, pvMsg);
+  RTCOSi_pstMain = pstPrevious;
+  return eRetVal;
+}
+#endif /* RTCOS_ENABLE_MESSAGES */
+
+#ifdef RTCOS_ENABLE_ISR_EVENTS
+/** ***********************************************************************************************
+  * @brief      Post an event to a task of an instance from an interrupt, see
+  *             rtcos_send_event_from_isr(). Interrupts must use this form: the instance bound to
+  *             the interrupted thread may be any
+  * @param      pstOs Instance of the task
+  * @param      u08TaskID ID of the task which will receive the event
+  * @param      u32EventFlags Bit feild event
+  * @return     Status as defined in ::rtcos_status_t
+  ********************************************************************************************** */
+rtcos_status_t rtcos_send_event_from_isr_r(rtcos_t *pstOs, uint8_t u08TaskID,
+                                           uint32_t u32EventFlags)
+{
+  rtcos_main_t *pstPrevious;
+  rtcos_status_t eRetVal;
+
+  pstPrevious = rtcos_bind(pstOs);
+  eRetVal = rtcos_send_event_from_isr(u08TaskID, u32EventFlags);
+  RTCOSi_pstMain = pstPrevious;
+  return eRetVal;
 }
+#endif /* RTCOS_ENABLE_ISR_EVENTS */
+#endif /* RTCOS_ENABLE_INSTANCES */
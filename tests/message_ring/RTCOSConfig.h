@@ -0,0 +1,30 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : RTCOSConfig.h
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : RTCOS configuration used by the message ring test
+ * 
+ **************************************************************************************************
+ */
+
+#ifndef RTCOS_CONFIG_H
+#define RTCOS_CONFIG_H
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENABLE_MESSAGE_RINGS
+
+#define RTCOS_MAX_TASKS_COUNT                    1
+#define RTCOS_MAX_FUTURE_EVENTS_COUNT            2
+#define RTCOS_MESSAGE_RING_SIZE                  64
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Macros                                                                                        */
+/*-----------------------------------------------------------------------------------------------*/
+#define RTCOS_ENTER_CRITICAL_SECTION()
+#define RTCOS_EXIT_CRITICAL_SECTION()
+
+#endif /* RTCOS_CONFIG_H */
@@ -0,0 +1,138 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Checks the size limits of rtcos_ring_reserve() and rtcos_ring_commit() around the
+ *            ring size and the 16 bits wrap, exits with the number of failed checks
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "rtcos.h"
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+#define RING_TASK_ID                             (uint8_t)0
+/** Largest message of a ring, the header takes 4 bytes */
+#define RING_MAX_MESSAGE_SIZE                    (uint16_t)(RTCOS_MESSAGE_RING_SIZE - 4)
+#define CHECK(bCondition)                        _check((bCondition), #bCondition, __LINE__)
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _ring_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg);
+static void _check(bool bCondition, char const *pcCondition, int iLine);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static int iFailuresCount;
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Exported functions                                                                            */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Program entry point
+  * @return     Number of failed checks
+  ********************************************************************************************** */
+int main(void)
+{
+  void *pvRoom;
+
+  rtcos_init();
+  rtcos_register_task_handler(_ring_task_handler, RING_TASK_ID, NULL);
+
+  /* Sizes that do not fit the ring, including the ones that wrapped once rounded on 16 bits */
+  CHECK(NULL == rtcos_ring_reserve(RING_TASK_ID, 0));
+  CHECK(NULL == rtcos_ring_reserve(RING_TASK_ID, (uint16_t)(RING_MAX_MESSAGE_SIZE + 1)));
+  CHECK(NULL == rtcos_ring_reserve(RING_TASK_ID, 65533));
+  CHECK(NULL == rtcos_ring_reserve(RING_TASK_ID, 65534));
+  CHECK(NULL == rtcos_ring_reserve(RING_TASK_ID, 65535));
+
+  /* Nothing reserved yet */
+  CHECK(RTCOS_ERR_ARG == rtcos_ring_commit(RING_TASK_ID, 1));
+
+  /* A commit may not go past the size asked, even inside the 4 bytes padding */
+  pvRoom = rtcos_ring_reserve(RING_TASK_ID, 5);
+  CHECK(NULL != pvRoom);
+  CHECK(RTCOS_ERR_ARG == rtcos_ring_commit(RING_TASK_ID, 6));
+  CHECK(RTCOS_ERR_ARG == rtcos_ring_commit(RING_TASK_ID, 65535));
+  CHECK(RTCOS_ERR_NONE == rtcos_ring_commit(RING_TASK_ID, 0));
+
+  /* The largest message takes the whole ring */
+  pvRoom = rtcos_ring_reserve(RING_TASK_ID, RING_MAX_MESSAGE_SIZE);
+  CHECK(NULL != pvRoom);
+  if(NULL != pvRoom)
+  {
+    memset(pvRoom, 0xA5, RING_MAX_MESSAGE_SIZE);
+  }
+  CHECK(RTCOS_ERR_ARG == rtcos_ring_commit(RING_TASK_ID, (uint16_t)(RING_MAX_MESSAGE_SIZE + 1)));
+  CHECK(RTCOS_ERR_NONE == rtcos_ring_commit(RING_TASK_ID, RING_MAX_MESSAGE_SIZE));
+  CHECK(NULL == rtcos_ring_reserve(RING_TASK_ID, 1));
+
+  rtcos_run();
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Read back the largest message, then check that the ring is free again
+  * @param      u32EventFlags Events of the task
+  * @param      u08MsgCount Number of messages of the task
+  * @param      pvArg Task argument
+  * @return     Unhandled events
+  ********************************************************************************************** */
+static uint32_t _ring_task_handler(uint32_t u32EventFlags, uint8_t u08MsgCount, void const *pvArg)
+{
+  uint8_t const *pu08Message;
+  uint16_t u16Size;
+
+  (void)u32EventFlags;
+  (void)u08MsgCount;
+  (void)pvArg;
+  u16Size = 0;
+  pu08Message = rtcos_ring_read(&u16Size);
+  CHECK(NULL != pu08Message);
+  CHECK(RING_MAX_MESSAGE_SIZE == u16Size);
+  if(NULL != pu08Message)
+  {
+    CHECK((0xA5 == pu08Message[0]) && (0xA5 == pu08Message[RING_MAX_MESSAGE_SIZE - 1]));
+  }
+  CHECK(RTCOS_ERR_NONE == rtcos_ring_release());
+  CHECK(NULL == rtcos_ring_read(&u16Size));
+
+  CHECK(NULL != rtcos_ring_reserve(RING_TASK_ID, RING_MAX_MESSAGE_SIZE));
+  CHECK(RTCOS_ERR_NONE == rtcos_ring_commit(RING_TASK_ID, 0));
+
+  printf("message_ring: %d failed check(s)\r\n", iFailuresCount);
+  exit(iFailuresCount);
+  return 0;
+}
+
+/** ***********************************************************************************************
+  * @brief      Count and report a failed check
+  * @param      bCondition Result of the check
+  * @param      pcCondition Text of the check
+  * @param      iLine Line of the check
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _check(bool bCondition, char const *pcCondition, int iLine)
+{
+  if(false == bCondition)
+  {
+    printf("line %d: %s failed\r\n", iLine, pcCondition);
+    ++iFailuresCount;
+  }
+}
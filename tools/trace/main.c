@@ -0,0 +1,351 @@
+/* 
+ **************************************************************************************************
+ *
+ * @file    : main.c
+ * @author  : Bayrem GHARSELLAOUI
+ * @date    : October 2026
+ * @brief   : Host side decoder turning a dump of the RTCOS trace ring buffer into a Chrome trace
+ *            JSON file that Perfetto (ui.perfetto.dev) or chrome://tracing can open
+ * 
+ **************************************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Includes                                                                                      */
+/*-----------------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Defines                                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+/** Dump layout, see rtcos_trace_t and rtcos_trace_record_t */
+#define TRACE_MAGIC                              0x54435452uL
+#define TRACE_VERSION                            1
+#define TRACE_HEADER_SIZE                        16
+#define TRACE_RECORD_SIZE                        12
+#define TRACE_NO_TASK                            0xFF
+/** Record kinds, see rtcos_trace_kind_t */
+#define TRACE_EVENT_POST                         0
+#define TRACE_MESSAGE_PUSH                       1
+#define TRACE_MESSAGE_POP                        2
+#define TRACE_DISPATCH_START                     3
+#define TRACE_DISPATCH_END                       4
+#define TRACE_TICK_START                         5
+#define TRACE_TICK_END                           6
+#define TRACE_TIMER_START                        7
+#define TRACE_TIMER_END                          8
+#define TRACE_IDLE_ENTER                         9
+#define TRACE_IDLE_EXIT                          10
+/** Tracks of the trace viewer, one per task then the scheduler ones */
+#define TRACK_TICKS                              256
+#define TRACK_TIMERS                             257
+#define TRACK_IDLE                               258
+#define TRACKS_COUNT                             259
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private function prototypes                                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+static uint32_t _read_u32(uint8_t const *pu08Data);
+static uint16_t _read_u16(uint8_t const *pu08Data);
+static void _print_slice(char cPhase, uint16_t u16Track, double dTime, char const *pcName,
+                         char const *pcArgName, uint32_t u32Value);
+static void _print_instant(uint16_t u16Track, double dTime, char const *pcName, uint32_t u32Value);
+static void _print_track_name(uint16_t u16Track);
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private variables                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+static bool bBigEndian;
+static bool bFirstEvent;
+static uint32_t tu32OpenSlices[TRACKS_COUNT];
+static bool tbTrackUsed[TRACKS_COUNT];
+
+/** ***********************************************************************************************
+  * @brief      Program entry point: rtcos_trace <dump> [ns per timestamp unit] > trace.json
+  * @return     0 on success, 1 if the dump cannot be decoded
+  ********************************************************************************************** */
+int main(int argc, char **argv)
+{
+  FILE *pstFile;
+  uint8_t *pu08Dump;
+  uint8_t const *pu08Record;
+  long s32Size;
+  double dNsPerUnit;
+  double dTime;
+  uint64_t u64Time;
+  uint32_t u32RecordsCount;
+  uint32_t u32Head;
+  uint32_t u32Position;
+  uint32_t u32Timestamp;
+  uint32_t u32LastTimestamp;
+  uint32_t u32Value;
+  uint32_t u32Dropped;
+  uint16_t u16Track;
+  uint8_t u08Kind;
+  uint8_t u08TaskID;
+  bool bFirstRecord;
+  char tcName[32];
+
+  if((argc < 2) || (NULL == (pstFile = fopen(argv[1], "rb"))))
+  {
+    fprintf(stderr, "usage: %s <trace dump> [ns per timestamp unit, 1 by default]\r\n", argv[0]);
+    return 1;
+  }
+  dNsPerUnit = (argc > 2) ? atof(argv[2]) : 1.0;
+  fseek(pstFile, 0, SEEK_END);
+  s32Size = ftell(pstFile);
+  fseek(pstFile, 0, SEEK_SET);
+  pu08Dump = malloc((size_t)s32Size);
+  if((s32Size < TRACE_HEADER_SIZE) || (NULL == pu08Dump) ||
+     (1 != fread(pu08Dump, (size_t)s32Size, 1, pstFile)))
+  {
+    fprintf(stderr, "cannot read %s\r\n", argv[1]);
+    return 1;
+  }
+  fclose(pstFile);
+  /* The magic tells the byte order of the target */
+  bBigEndian = false;
+  if(TRACE_MAGIC != _read_u32(pu08Dump))
+  {
+    bBigEndian = true;
+  }
+  u32RecordsCount = _read_u32(pu08Dump + 8);
+  u32Head = _read_u32(pu08Dump + 12);
+  if((TRACE_MAGIC != _read_u32(pu08Dump)) || (TRACE_VERSION != _read_u16(pu08Dump + 4)) ||
+     (TRACE_RECORD_SIZE != _read_u16(pu08Dump + 6)) ||
+     (0 != (u32RecordsCount & (u32RecordsCount - 1))) ||
+     ((unsigned long)s32Size <
+      TRACE_HEADER_SIZE + ((unsigned long)u32RecordsCount * TRACE_RECORD_SIZE)))
+  {
+    fprintf(stderr, "%s is not an RTCOS trace dump\r\n", argv[1]);
+    return 1;
+  }
+
+  printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  bFirstEvent = true;
+  bFirstRecord = true;
+  u64Time = 0;
+  u32LastTimestamp = 0;
+  u32Dropped = 0;
+  /* Oldest record first, the ring keeps the last u32RecordsCount ones */
+  u32Position = (u32Head > u32RecordsCount) ? (u32Head - u32RecordsCount) : 0;
+  for(; u32Position != u32Head; ++u32Position)
+  {
+    pu08Record = pu08Dump + TRACE_HEADER_SIZE +
+                 ((u32Position & (u32RecordsCount - 1)) * TRACE_RECORD_SIZE);
+    u32Timestamp = _read_u32(pu08Record);
+    u32Value = _read_u32(pu08Record + 4);
+    u08Kind = pu08Record[10];
+    u08TaskID = pu08Record[11];
+    /* Records being written or overwritten while the dump was taken */
+    if((uint16_t)u32Position != _read_u16(pu08Record + 8))
+    {
+      ++u32Dropped;
+      continue;
+    }
+    /* The timestamp wraps, interrupts may also write records slightly out of order */
+    if(false == bFirstRecord)
+    {
+      u64Time += (uint64_t)(int64_t)(int32_t)(u32Timestamp - u32LastTimestamp);
+    }
+    bFirstRecord = false;
+    u32LastTimestamp = u32Timestamp;
+    dTime = ((double)(int64_t)u64Time * dNsPerUnit) / 1000.0;
+    u16Track = (TRACE_NO_TASK == u08TaskID) ? TRACK_TICKS : u08TaskID;
+    switch(u08Kind)
+    {
+    case TRACE_EVENT_POST:
+      _print_instant(u16Track, dTime, "event", u32Value);
+      break;
+    case TRACE_MESSAGE_PUSH:
+      _print_instant(u16Track, dTime, "message push", u32Value);
+      break;
+    case TRACE_MESSAGE_POP:
+      _print_instant(u16Track, dTime, "message pop", u32Value);
+      break;
+    case TRACE_DISPATCH_START:
+      snprintf(tcName, sizeof(tcName), "task %u", (unsigned)u08TaskID);
+      _print_slice('B', u16Track, dTime, tcName, "events", u32Value);
+      break;
+    case TRACE_DISPATCH_END:
+      _print_slice('E', u16Track, dTime, NULL, "unhandled", u32Value);
+      break;
+    case TRACE_TICK_START:
+      _print_slice('B', TRACK_TICKS, dTime, "tick", "tick", u32Value);
+      break;
+    case TRACE_TICK_END:
+      _print_slice('E', TRACK_TICKS, dTime, NULL, "tick", u32Value);
+      break;
+    case TRACE_TIMER_START:
+      snprintf(tcName, sizeof(tcName), "timer %lu", (unsigned long)u32Value);
+      _print_slice('B', TRACK_TIMERS, dTime, tcName, "timer", u32Value);
+      break;
+    case TRACE_TIMER_END:
+      _print_slice('E', TRACK_TIMERS, dTime, NULL, "timer", u32Value);
+      break;
+    case TRACE_IDLE_ENTER:
+      _print_slice('B', TRACK_IDLE, dTime, "idle", NULL, 0);
+      break;
+    case TRACE_IDLE_EXIT:
+      _print_slice('E', TRACK_IDLE, dTime, NULL, NULL, 0);
+      break;
+    default:
+      ++u32Dropped;
+      break;
+    }
+  }
+  for(u16Track = 0; u16Track < TRACKS_COUNT; ++u16Track)
+  {
+    if(true == tbTrackUsed[u16Track])
+    {
+      _print_track_name(u16Track);
+    }
+  }
+  printf("\n]}\n");
+  fprintf(stderr, "%lu records decoded, %lu dropped\r\n",
+          (unsigned long)(u32Head - u32Dropped -
+                          ((u32Head > u32RecordsCount) ? (u32Head - u32RecordsCount) : 0)),
+          (unsigned long)u32Dropped);
+  free(pu08Dump);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------*/
+/* Private functions                                                                             */
+/*-----------------------------------------------------------------------------------------------*/
+/** ***********************************************************************************************
+  * @brief      Read a 32 bits word in the byte order of the target
+  * @param      pu08Data Address of the word in the dump
+  * @return     Word value
+  ********************************************************************************************** */
+static uint32_t _read_u32(uint8_t const *pu08Data)
+{
+  uint32_t u32Value;
+
+  if(true == bBigEndian)
+  {
+    u32Value = ((uint32_t)pu08Data[0] << 24) | ((uint32_t)pu08Data[1] << 16) |
+               ((uint32_t)pu08Data[2] << 8) | (uint32_t)pu08Data[3];
+  }
+  else
+  {
+    u32Value = ((uint32_t)pu08Data[3] << 24) | ((uint32_t)pu08Data[2] << 16) |
+               ((uint32_t)pu08Data[1] << 8) | (uint32_t)pu08Data[0];
+  }
+  return u32Value;
+}
+
+/** ***********************************************************************************************
+  * @brief      Read a 16 bits word in the byte order of the target
+  * @param      pu08Data Address of the word in the dump
+  * @return     Word value
+  ********************************************************************************************** */
+static uint16_t _read_u16(uint8_t const *pu08Data)
+{
+  uint16_t u16Value;
+
+  if(true == bBigEndian)
+  {
+    u16Value = (uint16_t)(((uint16_t)pu08Data[0] << 8) | pu08Data[1]);
+  }
+  else
+  {
+    u16Value = (uint16_t)(((uint16_t)pu08Data[1] << 8) | pu08Data[0]);
+  }
+  return u16Value;
+}
+
+/** ***********************************************************************************************
+  * @brief      Print the beginning or the end of a slice, an end whose beginning has been
+  *             overwritten in the ring is skipped
+  * @param      cPhase 'B' to begin the slice, 'E' to end it
+  * @param      u16Track Track of the slice
+  * @param      dTime Time in microseconds
+  * @param      pcName Name of the slice, only used to begin it
+  * @param      pcArgName Name of the record value or NULL to leave it out
+  * @param      u32Value Value of the record
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _print_slice(char cPhase, uint16_t u16Track, double dTime, char const *pcName,
+                         char const *pcArgName, uint32_t u32Value)
+{
+  if('B' == cPhase)
+  {
+    ++tu32OpenSlices[u16Track];
+  }
+  else if(0 == tu32OpenSlices[u16Track])
+  {
+    return;
+  }
+  else
+  {
+    --tu32OpenSlices[u16Track];
+  }
+  tbTrackUsed[u16Track] = true;
+  printf("%s{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", bFirstEvent ? "" : ",\n",
+         cPhase, (unsigned)u16Track, dTime);
+  if(NULL != pcName)
+  {
+    printf(",\"name\":\"%s\"", pcName);
+  }
+  if(NULL != pcArgName)
+  {
+    printf(",\"args\":{\"%s\":\"0x%08lX\"}", pcArgName, (unsigned long)u32Value);
+  }
+  printf("}");
+  bFirstEvent = false;
+}
+
+/** ***********************************************************************************************
+  * @brief      Print an instant event
+  * @param      u16Track Track of the event
+  * @param      dTime Time in microseconds
+  * @param      pcName Name of the event
+  * @param      u32Value Event flags or message pointer
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _print_instant(uint16_t u16Track, double dTime, char const *pcName, uint32_t u32Value)
+{
+  tbTrackUsed[u16Track] = true;
+  printf("%s{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"%s\","
+         "\"args\":{\"value\":\"0x%08lX\"}}",
+         bFirstEvent ? "" : ",\n", (unsigned)u16Track, dTime, pcName, (unsigned long)u32Value);
+  bFirstEvent = false;
+}
+
+/** ***********************************************************************************************
+  * @brief      Name a track and sort the tracks by task priority, scheduler tracks last
+  * @param      u16Track Track to name
+  * @return     Nothing
+  ********************************************************************************************** */
+static void _print_track_name(uint16_t u16Track)
+{
+  char tcName[32];
+
+  switch(u16Track)
+  {
+  case TRACK_TICKS:
+    strcpy(tcName, "ticks");
+    break;
+  case TRACK_TIMERS:
+    strcpy(tcName, "timers");
+    break;
+  case TRACK_IDLE:
+    strcpy(tcName, "idle");
+    break;
+  default:
+    snprintf(tcName, sizeof(tcName), "task %u", (unsigned)u16Track);
+    break;
+  }
+  printf("%s{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+         "\"args\":{\"name\":\"%s\"}},\n"
+         "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_sort_index\","
+         "\"args\":{\"sort_index\":%u}}",
+         bFirstEvent ? "" : ",\n", (unsigned)u16Track, tcName, (unsigned)u16Track,
+         (unsigned)u16Track);
+  bFirstEvent = false;
+}